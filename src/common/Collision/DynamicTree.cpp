@@ -104,7 +104,7 @@ struct DynTreeImpl : public ParentTree/*, public Intersectable*/
     int unbalanced_times;
 };
 
-DynamicMapTree::DynamicMapTree() : impl(new DynTreeImpl()) { }
+DynamicMapTree::DynamicMapTree() : impl(new DynTreeImpl()), _generation(0) { }
 
 DynamicMapTree::~DynamicMapTree()
 {
@@ -114,11 +114,13 @@ DynamicMapTree::~DynamicMapTree()
 void DynamicMapTree::insert(const GameObjectModel& mdl)
 {
     impl->insert(mdl);
+    collisionChanged();
 }
 
 void DynamicMapTree::remove(const GameObjectModel& mdl)
 {
     impl->remove(mdl);
+    collisionChanged();
 }
 
 bool DynamicMapTree::contains(const GameObjectModel& mdl) const
@@ -231,6 +233,17 @@ bool DynamicMapTree::isInLineOfSight(G3D::Vector3 const& startPos, G3D::Vector3
     return !callback.didHit();
 }
 
+void DynamicMapTree::isInLineOfSight(G3D::Vector3 const& startPos, G3D::Vector3 const* targets, uint32 count, bool* results, PhaseShift const& phaseShift) const
+{
+    // most maps have no collidable gameobjects at all
+    if (impl->empty())
+        return;
+
+    for (uint32 i = 0; i < count; ++i)
+        if (results[i] && !isInLineOfSight(startPos, targets[i], phaseShift))
+            results[i] = false;
+}
+
 float DynamicMapTree::getHeight(float x, float y, float z, float maxSearchDist, PhaseShift const& phaseShift) const
 {
     G3D::Vector3 v(x, y, z + 0.5f);
@@ -21,6 +21,7 @@
 #define _DYNTREE_H
 
 #include "Define.h"
+#include <atomic>
 
 namespace G3D
 {
@@ -35,6 +36,7 @@ struct DynTreeImpl;
 class TC_COMMON_API DynamicMapTree
 {
     DynTreeImpl *impl;
+    std::atomic<uint32> _generation;
 
 public:
 
@@ -42,6 +44,8 @@ public:
     ~DynamicMapTree();
 
     bool isInLineOfSight(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos, PhaseShift const& phaseShift) const;
+    // results[i] is cleared when the ray to targets[i] is blocked, clear rays are left untouched
+    void isInLineOfSight(G3D::Vector3 const& startPos, G3D::Vector3 const* targets, uint32 count, bool* results, PhaseShift const& phaseShift) const;
     bool getIntersectionTime(G3D::Ray const& ray, G3D::Vector3 const& endPos, PhaseShift const& phaseShift, float& maxDist) const;
     bool getObjectHitPos(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos, G3D::Vector3& resultHitPos, float modifyDist, PhaseShift const& phaseShift) const;
 
@@ -54,6 +58,10 @@ public:
 
     void balance();
     void update(uint32 diff);
+
+    // changes whenever a model is added, removed or has its collision toggled (doors opening and closing)
+    uint32 getGeneration() const { return _generation.load(std::memory_order_relaxed); }
+    void collisionChanged() { ++_generation; }
 };
 
 #endif // _DYNTREE_H
@@ -26,6 +26,75 @@ namespace MMAP
     static char const* const MAP_FILE_NAME_FORMAT = "%smmaps/%04i.mmap";
     static char const* const TILE_FILE_NAME_FORMAT = "%smmaps/%04i%02i%02i.mmtile";
 
+    // ######################## MMapData ########################
+    dtNavMeshQuery* MMapData::AcquireQuery()
+    {
+        for (std::atomic<dtNavMeshQuery*>& slot : pooledQueries)
+            if (dtNavMeshQuery* query = slot.exchange(nullptr, std::memory_order_acquire))
+                return query;
+
+        // pool is empty, every other query is in use
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        ASSERT(query);
+        if (dtStatusFailed(query->init(navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            return nullptr;
+        }
+
+        return query;
+    }
+
+    void MMapData::ReleaseQuery(dtNavMeshQuery* query)
+    {
+        for (std::atomic<dtNavMeshQuery*>& slot : pooledQueries)
+        {
+            dtNavMeshQuery* empty = nullptr;
+            if (slot.compare_exchange_strong(empty, query, std::memory_order_release, std::memory_order_relaxed))
+                return;
+        }
+
+        dtFreeNavMeshQuery(query);
+    }
+
+    // ######################## NavMeshQueryHandle ########################
+    NavMeshQueryHandle::NavMeshQueryHandle(NavMeshQueryHandle&& other) : _data(other._data), _query(other._query), _lock(std::move(other._lock))
+    {
+        other._data = nullptr;
+        other._query = nullptr;
+    }
+
+    NavMeshQueryHandle& NavMeshQueryHandle::operator=(NavMeshQueryHandle&& other)
+    {
+        if (this != &other)
+        {
+            Release();
+            _data = other._data;
+            _query = other._query;
+            _lock = std::move(other._lock);
+            other._data = nullptr;
+            other._query = nullptr;
+        }
+
+        return *this;
+    }
+
+    NavMeshQueryHandle::~NavMeshQueryHandle()
+    {
+        Release();
+    }
+
+    void NavMeshQueryHandle::Release()
+    {
+        if (_query)
+            _data->ReleaseQuery(_query);
+
+        _data = nullptr;
+        _query = nullptr;
+        if (_lock.owns_lock())
+            _lock.unlock();
+    }
+
     // ######################## MMapManager ########################
     MMapManager::~MMapManager()
     {
@@ -212,6 +281,7 @@ namespace MMAP
         dtTileRef tileRef = 0;
 
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
+        std::unique_lock<std::shared_timed_mutex> lock(mmap->navMeshLock);
         if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
         {
             mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
@@ -300,6 +370,7 @@ namespace MMAP
         }
 
         // unload, and mark as non loaded
+        std::unique_lock<std::shared_timed_mutex> lock(mmap->navMeshLock);
         if (dtStatusFailed(mmap->navMesh->removeTile(tileRefItr->second, nullptr, nullptr)))
         {
             // this is technically a memory leak
@@ -341,6 +412,7 @@ namespace MMAP
 
         // unload all tiles from given map
         MMapData* mmap = itr->second;
+        std::unique_lock<std::shared_timed_mutex> lock(mmap->navMeshLock);
         for (MMapTileSet::iterator i = mmap->loadedTileRefs.begin(); i != mmap->loadedTileRefs.end(); ++i)
         {
             uint32 x = (i->first >> 16);
@@ -354,6 +426,7 @@ namespace MMAP
             }
         }
 
+        lock.unlock();
         delete mmap;
         itr->second = nullptr;
         TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded %04i.mmap", mapId);
@@ -409,4 +482,22 @@ namespace MMAP
 
         return queryItr->second;
     }
+
+    NavMeshQueryHandle MMapManager::AcquireNavMeshQuery(uint32 mapId)
+    {
+        auto itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return NavMeshQueryHandle();
+
+        MMapData* mmap = itr->second;
+        std::shared_lock<std::shared_timed_mutex> lock(mmap->navMeshLock);
+        dtNavMeshQuery* query = mmap->AcquireQuery();
+        if (!query)
+        {
+            TC_LOG_ERROR("maps", "MMAP:AcquireNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %04u", mapId);
+            return NavMeshQueryHandle();
+        }
+
+        return NavMeshQueryHandle(mmap, query, std::move(lock));
+    }
 }
@@ -22,6 +22,9 @@
 #include "Define.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
+#include <array>
+#include <atomic>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -35,23 +38,66 @@ namespace MMAP
     // dummy struct to hold map's mmap data
     struct TC_COMMON_API MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) { }
+        MMapData(dtNavMesh* mesh) : navMesh(mesh)
+        {
+            for (std::atomic<dtNavMeshQuery*>& query : pooledQueries)
+                query = nullptr;
+        }
+
         ~MMapData()
         {
             for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
                 dtFreeNavMeshQuery(i->second);
 
+            for (std::atomic<dtNavMeshQuery*>& query : pooledQueries)
+                dtFreeNavMeshQuery(query.load());
+
             if (navMesh)
                 dtFreeNavMesh(navMesh);
         }
 
+        dtNavMeshQuery* AcquireQuery();
+        void ReleaseQuery(dtNavMeshQuery* query);
+
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
 
+        // idle queries handed out by MMapManager::AcquireNavMeshQuery, a slot holding nullptr is empty
+        std::array<std::atomic<dtNavMeshQuery*>, 32> pooledQueries;
+
+        // held shared while a query runs, exclusive while tiles are added or removed
+        std::shared_timed_mutex navMeshLock;
+
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs;        // maps [map grid coords] to [dtTile]
     };
 
+    // dtNavMeshQuery for exclusive use by the holder, usable from any thread
+    // tiles of the navmesh are not added or removed while it is alive, keep it only for the duration of a path search
+    class TC_COMMON_API NavMeshQueryHandle
+    {
+        public:
+            NavMeshQueryHandle() : _data(nullptr), _query(nullptr) { }
+            NavMeshQueryHandle(MMapData* data, dtNavMeshQuery* query, std::shared_lock<std::shared_timed_mutex>&& lock)
+                : _data(data), _query(query), _lock(std::move(lock)) { }
+            NavMeshQueryHandle(NavMeshQueryHandle&& other);
+            NavMeshQueryHandle& operator=(NavMeshQueryHandle&& other);
+            ~NavMeshQueryHandle();
+
+            NavMeshQueryHandle(NavMeshQueryHandle const&) = delete;
+            NavMeshQueryHandle& operator=(NavMeshQueryHandle const&) = delete;
+
+            dtNavMeshQuery const* get() const { return _query; }
+            explicit operator bool() const { return _query != nullptr; }
+
+        private:
+            void Release();
+
+            MMapData* _data;
+            dtNavMeshQuery* _query;
+            std::shared_lock<std::shared_timed_mutex> _lock;
+    };
+
 
     typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
 
@@ -72,6 +118,8 @@ namespace MMAP
 
             // the returned [dtNavMeshQuery const*] is NOT threadsafe
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+            // pooled query that can be used concurrently with other handles of the same map
+            NavMeshQueryHandle AcquireNavMeshQuery(uint32 mapId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
@@ -16,6 +16,7 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <string>
@@ -208,6 +209,24 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, Vector3 const* targets, uint32 count, bool* results)
+    {
+        std::fill(results, results + count, true);
+        if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+            return;
+
+        auto instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        std::vector<Vector3> positions;
+        positions.reserve(count);
+        for (uint32 i = 0; i < count; ++i)
+            positions.push_back(convertPositionToInternalRep(targets[i].x, targets[i].y, targets[i].z));
+
+        instanceTree->second->isInLineOfSight(convertPositionToInternalRep(x1, y1, z1), positions.data(), count, results);
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -112,6 +112,7 @@ namespace VMAP
             void unloadSingleMap(uint32 mapId);
 
             bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2) override ;
+            void isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, G3D::Vector3 const* targets, uint32 count, bool* results) override;
             /**
             fill the hit pos and return true, if an object was hit
             */
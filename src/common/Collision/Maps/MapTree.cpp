@@ -174,6 +174,53 @@ namespace VMAP
     }
     //=========================================================
     /**
+    Line of sight from one origin to many targets (area spells, aggro checks).
+    The tree is walked once for the box enclosing all rays, each ray is then
+    only tested against the models found there.
+    */
+
+    void StaticMapTree::isInLineOfSight(const Vector3& origin, const Vector3* targets, uint32 count, bool* results) const
+    {
+        if (!count)
+            return;
+
+        G3D::AABox box(origin, origin);
+        for (uint32 i = 0; i < count; ++i)
+            box.merge(targets[i]);
+
+        std::vector<uint32> candidates;
+        auto gatherCandidates = [&candidates](uint32 entry) { candidates.push_back(entry); };
+        iTree.intersectBox(box, gatherCandidates);
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            Vector3 const& target = targets[i];
+            float maxDist = (target - origin).magnitude();
+            // same guards as the single ray version
+            if (maxDist == std::numeric_limits<float>::max() || !std::isfinite(maxDist))
+            {
+                results[i] = false;
+                continue;
+            }
+
+            results[i] = true;
+            if (maxDist < 1e-10f)
+                continue;
+
+            G3D::Ray ray = G3D::Ray::fromOriginAndDirection(origin, (target - origin) / maxDist);
+            for (uint32 entry : candidates)
+            {
+                float distance = maxDist;
+                if (iTreeValues[entry].intersectRay(ray, distance, true))
+                {
+                    results[i] = false;
+                    break;
+                }
+            }
+        }
+    }
+    //=========================================================
+    /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
     Return the hit pos or the original dest pos
     */
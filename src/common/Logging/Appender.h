@@ -42,6 +42,8 @@ class TC_COMMON_API Appender
         void write(LogMessage* message);
         static const char* getLogLevelString(LogLevel level);
         virtual void setRealmId(uint32 /*realmId*/, std::string /*realmName*/ = "") { }
+        // called by the async log writer after each batch of messages
+        virtual void flush() { }
 
     private:
         virtual void _write(LogMessage const* /*message*/) = 0;
@@ -25,13 +25,12 @@
 #include "Errors.h"
 #include "Logger.h"
 #include "LogMessage.h"
-#include "LogOperation.h"
-#include "Strand.h"
 #include "Util.h"
 #include <chrono>
 #include <sstream>
 
-Log::Log() : AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _ioContext(nullptr), _strand(nullptr)
+Log::Log() : AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _generation(1), _async(false), _queuedMessages(0), _droppedMessages(0),
+    _maxQueuedMessages(0), _stopWriterThread(false)
 {
     m_logsTimestamp = "_" + GetTimestampStr();
     RegisterAppender<AppenderConsole>();
@@ -41,7 +40,7 @@ Log::Log() : AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _ioContext(nullptr)
 
 Log::~Log()
 {
-    delete _strand;
+    StopWriterThread();
     Close();
 }
 
@@ -226,17 +225,87 @@ void Log::outCommand(std::string&& message, std::string&& param1)
     write(Trinity::make_unique<LogMessage>(LOG_LEVEL_INFO, "commands.gm", std::move(message), std::move(param1)));
 }
 
-void Log::write(std::unique_ptr<LogMessage>&& msg) const
+void Log::write(std::unique_ptr<LogMessage>&& msg)
 {
-    Logger const* logger = GetLoggerByType(msg->type);
+    if (!_async)
+    {
+        GetLoggerByType(msg->type)->write(msg.get());
+        return;
+    }
 
-    if (_ioContext)
+    // errors are never dropped, everything else is once the writer thread falls too far behind
+    uint32 queued = _queuedMessages.fetch_add(1);
+    if (_maxQueuedMessages && queued >= _maxQueuedMessages && msg->level < LOG_LEVEL_ERROR)
     {
-        std::shared_ptr<LogOperation> logOperation = std::make_shared<LogOperation>(logger, std::move(msg));
-        Trinity::Asio::post(*_ioContext, Trinity::Asio::bind_executor(*_strand, [logOperation]() { logOperation->call(); }));
+        --_queuedMessages;
+        ++_droppedMessages;
+        return;
     }
-    else
-        logger->write(msg.get());
+
+    _queue.Enqueue(msg.release());
+    if (!queued)
+        _writerCondition.notify_one();
+}
+
+void Log::StartWriterThread()
+{
+    _stopWriterThread = false;
+    _writerThread = Trinity::make_unique<std::thread>(&Log::WriterThread, this);
+}
+
+void Log::StopWriterThread()
+{
+    if (!_writerThread)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_writerLock);
+        _stopWriterThread = true;
+    }
+
+    _writerCondition.notify_one();
+    _writerThread->join();
+    _writerThread.reset();
+}
+
+void Log::WriterThread()
+{
+    while (true)
+    {
+        WriteQueuedMessages();
+
+        std::unique_lock<std::mutex> lock(_writerLock);
+        if (_stopWriterThread)
+            break;
+
+        // the timeout covers a notification sent between the queue check and the wait
+        _writerCondition.wait_for(lock, std::chrono::milliseconds(100), [this]() { return _queuedMessages || _stopWriterThread; });
+    }
+
+    WriteQueuedMessages();
+}
+
+void Log::WriteQueuedMessages()
+{
+    LogMessage* msg;
+    while (_queue.Dequeue(msg))
+    {
+        --_queuedMessages;
+        std::unique_ptr<LogMessage> message(msg);
+        // the logger configuration may have changed since the message was queued
+        if (Logger const* logger = GetLoggerByType(message->type))
+            logger->write(message.get());
+    }
+
+    if (uint32 dropped = _droppedMessages.exchange(0))
+    {
+        LogMessage message(LOG_LEVEL_WARN, "server", Trinity::StringFormat("Log queue is full (Log.Async.QueueSize = %u), %u messages were dropped", _maxQueuedMessages, dropped));
+        if (Logger const* logger = GetLoggerByType(message.type))
+            logger->write(&message);
+    }
+
+    for (std::pair<uint8 const, std::unique_ptr<Appender>> const& appender : appenders)
+        appender.second->flush();
 }
 
 Logger const* Log::GetLoggerByType(std::string const& type) const
@@ -256,6 +325,23 @@ Logger const* Log::GetLoggerByType(std::string const& type) const
     return GetLoggerByType(parentLogger);
 }
 
+uint32 Log::ResolveCallSite(LogCallSite& callSite, char const* type) const
+{
+    // read the generation first, a configuration change during the lookup only makes the next call resolve again
+    uint32 generation = _generation.load(std::memory_order_relaxed);
+    Logger const* logger = GetLoggerByType(type);
+    uint32 state = (generation << 8) | uint32(logger ? logger->getLogLevel() : LOG_LEVEL_DISABLED);
+    callSite._state.store(state, std::memory_order_relaxed);
+    return state;
+}
+
+void Log::InvalidateCallSites()
+{
+    // generation 0 is reserved for call sites that were never resolved
+    uint32 generation = (_generation.load(std::memory_order_relaxed) + 1) & 0xFFFFFF;
+    _generation.store(generation ? generation : 1, std::memory_order_relaxed);
+}
+
 std::string Log::GetTimestampStr()
 {
     time_t tt = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
@@ -298,6 +384,7 @@ bool Log::SetLogLevel(std::string const& name, const char* newLevelc, bool isLog
             return false;
 
         it->second->setLogLevel(newLevel);
+        InvalidateCallSites();
 
         if (newLevel != LOG_LEVEL_DISABLED && newLevel < lowestLogLevel)
             lowestLogLevel = newLevel;
@@ -342,6 +429,7 @@ void Log::Close()
 {
     loggers.clear();
     appenders.clear();
+    InvalidateCallSites();
 }
 
 bool Log::ShouldLog(std::string const& type, LogLevel level) const
@@ -368,26 +456,22 @@ Log* Log::instance()
     return &instance;
 }
 
-void Log::Initialize(Trinity::Asio::IoContext* ioContext)
+void Log::Initialize(bool async)
 {
-    if (ioContext)
-    {
-        _ioContext = ioContext;
-        _strand = new Trinity::Asio::Strand(*ioContext);
-    }
-
+    _async = async;
     LoadFromConfig();
 }
 
 void Log::SetSynchronous()
 {
-    delete _strand;
-    _strand = nullptr;
-    _ioContext = nullptr;
+    _async = false;
+    StopWriterThread();
 }
 
 void Log::LoadFromConfig()
 {
+    // queued messages are kept while the loggers are replaced and written with the new ones
+    StopWriterThread();
     Close();
 
     lowestLogLevel = LOG_LEVEL_FATAL;
@@ -399,4 +483,9 @@ void Log::LoadFromConfig()
 
     ReadAppendersFromConfig();
     ReadLoggersFromConfig();
+    InvalidateCallSites();
+
+    _maxQueuedMessages = sConfigMgr->GetIntDefault("Log.Async.QueueSize", 100000);
+    if (_async)
+        StartWriterThread();
 }
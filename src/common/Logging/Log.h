@@ -20,10 +20,14 @@
 #define TRINITYCORE_LOG_H
 
 #include "Define.h"
-#include "AsioHacksFwd.h"
 #include "LogCommon.h"
+#include "MPSCQueue.h"
 #include "StringFormat.h"
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -31,15 +35,21 @@ class Appender;
 class Logger;
 struct LogMessage;
 
-namespace Trinity
+#define LOGGER_ROOT "root"
+
+/// Logger lookup result cached by a single TC_LOG_* statement, valid until the logger configuration changes.
+/// Constant initialized, so the function local statics holding it need no initialization guard.
+class LogCallSite
 {
-    namespace Asio
-    {
-        class IoContext;
-    }
-}
+    friend class Log;
 
-#define LOGGER_ROOT "root"
+    public:
+        constexpr LogCallSite() : _state(0) { }
+
+    private:
+        // configuration generation it was resolved for in the upper 24 bits, log level of its logger in the lower 8
+        std::atomic<uint32> _state;
+};
 
 typedef Appender*(*AppenderCreatorFn)(uint8 id, std::string const& name, LogLevel level, AppenderFlags flags, std::vector<char const*>&& extraArgs);
 
@@ -62,11 +72,41 @@ class TC_COMMON_API Log
     public:
         static Log* instance();
 
-        void Initialize(Trinity::Asio::IoContext* ioContext);
+        void Initialize(bool async);
         void SetSynchronous();  // Not threadsafe - should only be called from main() after all threads are joined
         void LoadFromConfig();
         void Close();
         bool ShouldLog(std::string const& type, LogLevel level) const;
+
+        // string literal filters are looked up only once per call site and configuration change
+        template<std::size_t N>
+        bool ShouldLog(LogCallSite& callSite, char const (&type)[N], LogLevel level) const
+        {
+            // Don't even look for a logger if the LogLevel is lower than lowest log levels across all loggers
+            if (level < lowestLogLevel)
+                return false;
+
+            uint32 state = callSite._state.load(std::memory_order_relaxed);
+            if ((state >> 8) != _generation.load(std::memory_order_relaxed))
+                state = ResolveCallSite(callSite, type);
+
+            LogLevel logLevel = LogLevel(state & 0xFF);
+            return logLevel != LOG_LEVEL_DISABLED && logLevel <= level;
+        }
+
+        // filters built at runtime can change between calls of the same statement
+        bool ShouldLog(LogCallSite& /*callSite*/, std::string const& type, LogLevel level) const
+        {
+            return ShouldLog(type, level);
+        }
+
+        // mutable buffers are preferred over the string literal overload, their content can change between calls
+        template<std::size_t N>
+        bool ShouldLog(LogCallSite& /*callSite*/, char (&type)[N], LogLevel level) const
+        {
+            return ShouldLog(std::string(type), level);
+        }
+
         bool SetLogLevel(std::string const& name, char const* level, bool isLogger = true);
 
         template<typename Format, typename... Args>
@@ -97,12 +137,15 @@ class TC_COMMON_API Log
 
         std::string const& GetLogsDir() const { return m_logsDir; }
         std::string const& GetLogsTimestamp() const { return m_logsTimestamp; }
+        bool IsAsync() const { return _async; }
 
     private:
         static std::string GetTimestampStr();
-        void write(std::unique_ptr<LogMessage>&& msg) const;
+        void write(std::unique_ptr<LogMessage>&& msg);
 
         Logger const* GetLoggerByType(std::string const& type) const;
+        uint32 ResolveCallSite(LogCallSite& callSite, char const* type) const;
+        void InvalidateCallSites();
         Appender* GetAppenderByName(std::string const& name);
         uint8 NextAppenderId();
         void CreateAppenderFromConfig(std::string const& name);
@@ -110,6 +153,10 @@ class TC_COMMON_API Log
         void ReadAppendersFromConfig();
         void ReadLoggersFromConfig();
         void RegisterAppender(uint8 index, AppenderCreatorFn appenderCreateFn);
+        void StartWriterThread();
+        void StopWriterThread();
+        void WriterThread();
+        void WriteQueuedMessages();
         void outMessage(std::string const& filter, LogLevel const level, std::string&& message);
         void outCommand(std::string&& message, std::string&& param1);
 
@@ -118,12 +165,22 @@ class TC_COMMON_API Log
         std::unordered_map<std::string, std::unique_ptr<Logger>> loggers;
         uint8 AppenderId;
         LogLevel lowestLogLevel;
+        std::atomic<uint32> _generation;
 
         std::string m_logsDir;
         std::string m_logsTimestamp;
 
-        Trinity::Asio::IoContext* _ioContext;
-        Trinity::Asio::Strand* _strand;
+        // async logging: messages are queued by any thread and written by a single writer thread,
+        // which flushes the appenders once per batch instead of once per message
+        std::atomic<bool> _async;
+        MPSCQueue<LogMessage> _queue;
+        std::atomic<uint32> _queuedMessages;
+        std::atomic<uint32> _droppedMessages;
+        uint32 _maxQueuedMessages;
+        std::unique_ptr<std::thread> _writerThread;
+        std::atomic<bool> _stopWriterThread;
+        std::mutex _writerLock;
+        std::condition_variable _writerCondition;
 };
 
 #define sLog Log::instance()
@@ -148,7 +205,8 @@ void check_args(std::string const&, ...);
 // This will catch format errors on build time
 #define TC_LOG_MESSAGE_BODY(filterType__, level__, ...)                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
+            static LogCallSite logCallSite__;                           \
+            if (sLog->ShouldLog(logCallSite__, filterType__, level__))  \
             {                                                           \
                 if (false)                                              \
                     check_args(__VA_ARGS__);                            \
@@ -161,7 +219,8 @@ void check_args(std::string const&, ...);
         __pragma(warning(push))                                         \
         __pragma(warning(disable:4127))                                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
+            static LogCallSite logCallSite__;                           \
+            if (sLog->ShouldLog(logCallSite__, filterType__, level__))  \
                 LOG_EXCEPTION_FREE(filterType__, level__, __VA_ARGS__); \
         } while (0)                                                     \
         __pragma(warning(pop))
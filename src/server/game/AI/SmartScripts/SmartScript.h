@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "SmartScriptMgr.h"
+#include <array>
 
 class Creature;
 class GameObject;
@@ -118,6 +119,9 @@ class TC_GAME_API SmartScript
         void SetPhase(uint32 p = 0) { mEventPhase = p; }
 
         SmartAIEventList mEvents;
+        // positions in mEvents grouped by event type, events of type t are listed from mEventIndexOffsets[t] to mEventIndexOffsets[t + 1]
+        std::vector<uint32> mEventIndex;
+        std::array<uint32, SMART_EVENT_END + 1> mEventIndexOffsets;
         SmartAIEventList mInstallEvents;
         SmartAIEventList mTimedActionList;
         bool isProcessingTimedActionList;
@@ -141,6 +145,7 @@ class TC_GAME_API SmartScript
 
         SMARTAI_TEMPLATE mTemplate;
         void InstallEvents();
+        void BuildEventIndex();
 
         void RemoveStoredEvent(uint32 id);
 };
@@ -307,15 +307,13 @@ void SmartAIMgr::LoadSmartAIFromDB()
 
 SmartAIEventList SmartAIMgr::GetScript(int32 entry, SmartScriptType type)
 {
-    SmartAIEventList temp;
-    if (mEventMap[uint32(type)].find(entry) != mEventMap[uint32(type)].end())
-        return mEventMap[uint32(type)][entry];
-    else
-    {
-        if (entry > 0)//first search is for guid (negative), do not drop error if not found
-            TC_LOG_DEBUG("scripts.ai", "SmartAIMgr::GetScript: Could not load Script for Entry %d ScriptType %u.", entry, uint32(type));
-        return temp;
-    }
+    SmartAIEventMap::const_iterator itr = mEventMap[uint32(type)].find(entry);
+    if (itr != mEventMap[uint32(type)].end())
+        return itr->second;
+
+    if (entry > 0)//first search is for guid (negative), do not drop error if not found
+        TC_LOG_DEBUG("scripts.ai", "SmartAIMgr::GetScript: Could not load Script for Entry %d ScriptType %u.", entry, uint32(type));
+    return SmartAIEventList();
 }
 
 SmartScriptHolder& SmartAIMgr::FindLinkedSourceEvent(SmartAIEventList& list, uint32 eventId)
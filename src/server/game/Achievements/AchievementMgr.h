@@ -104,6 +104,7 @@ protected:
 
     std::string GetOwnerInfo() const override;
     CriteriaList const& GetCriteriaByType(CriteriaTypes type) const override;
+    CriteriaList const& GetCriteriaByAsset(CriteriaTypes type, uint32 asset) const override;
 
 private:
     Player* _owner;
@@ -137,6 +138,7 @@ protected:
 
     std::string GetOwnerInfo() const override;
     CriteriaList const& GetCriteriaByType(CriteriaTypes type) const override;
+    CriteriaList const& GetCriteriaByAsset(CriteriaTypes type, uint32 asset) const override;
 
 private:
     Guild* _owner;
@@ -446,7 +446,9 @@ void CriteriaHandler::UpdateCriteria(CriteriaTypes type, uint64 miscValue1 /*= 0
     TC_LOG_DEBUG("criteria", "CriteriaHandler::UpdateCriteria(%s, %u, " UI64FMTD ", " UI64FMTD ", " UI64FMTD ") %s",
         CriteriaMgr::GetCriteriaTypeString(type), type, miscValue1, miscValue2, miscValue3, GetOwnerInfo().c_str());
 
-    CriteriaList const& criteriaList = GetCriteriaByType(type);
+    // when the event names its asset only criteria with that asset can be updated
+    bool byAsset = miscValue1 && miscValue1 <= std::numeric_limits<uint32>::max() && CriteriaMgr::IsAssetIndexedCriteriaType(type);
+    CriteriaList const& criteriaList = byAsset ? GetCriteriaByAsset(type, uint32(miscValue1)) : GetCriteriaByType(type);
     for (Criteria const* criteria : criteriaList)
     {
         CriteriaTreeList const* trees = sCriteriaMgr->GetCriteriaTreesByCriteria(criteria->ID);
@@ -2367,6 +2369,8 @@ void CriteriaMgr::LoadCriteriaList()
 
         _criteria[criteria->ID] = criteria;
 
+        bool indexByAsset = IsAssetIndexedCriteriaType(CriteriaTypes(criteriaEntry->Type));
+
         for (CriteriaTree const* tree : treeItr->second)
         {
             if (AchievementEntry const* achievement = tree->Achievement)
@@ -2388,24 +2392,32 @@ void CriteriaMgr::LoadCriteriaList()
         {
             ++criterias;
             _criteriasByType[criteriaEntry->Type].push_back(criteria);
+            if (indexByAsset)
+                _criteriasByAsset[criteriaEntry->Type][criteriaEntry->Asset.ID].push_back(criteria);
         }
 
         if (criteria->FlagsCu & CRITERIA_FLAG_CU_GUILD)
         {
             ++guildCriterias;
             _guildCriteriasByType[criteriaEntry->Type].push_back(criteria);
+            if (indexByAsset)
+                _guildCriteriasByAsset[criteriaEntry->Type][criteriaEntry->Asset.ID].push_back(criteria);
         }
 
         if (criteria->FlagsCu & CRITERIA_FLAG_CU_SCENARIO)
         {
             ++scenarioCriterias;
             _scenarioCriteriasByType[criteriaEntry->Type].push_back(criteria);
+            if (indexByAsset)
+                _scenarioCriteriasByAsset[criteriaEntry->Type][criteriaEntry->Asset.ID].push_back(criteria);
         }
 
         if (criteria->FlagsCu & CRITERIA_FLAG_CU_QUEST_OBJECTIVE)
         {
             ++questObjectiveCriterias;
             _questObjectiveCriteriasByType[criteriaEntry->Type].push_back(criteria);
+            if (indexByAsset)
+                _questObjectiveCriteriasByAsset[criteriaEntry->Type][criteriaEntry->Asset.ID].push_back(criteria);
         }
 
         if (criteriaEntry->StartTimer)
@@ -2418,6 +2430,51 @@ void CriteriaMgr::LoadCriteriaList()
     TC_LOG_INFO("server.loading", ">> Loaded %u criteria, %u guild criteria, %u scenario criteria and %u quest objective criteria in %u ms.", criterias, guildCriterias, scenarioCriterias, questObjectiveCriterias, GetMSTimeDiffToNow(oldMSTime));
 }
 
+bool CriteriaMgr::IsAssetIndexedCriteriaType(CriteriaTypes type)
+{
+    switch (type)
+    {
+        case CRITERIA_TYPE_KILL_CREATURE:
+        case CRITERIA_TYPE_KILLED_BY_CREATURE:
+        case CRITERIA_TYPE_REACH_SKILL_LEVEL:
+        case CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+        case CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+        case CRITERIA_TYPE_COMPLETE_QUEST:
+        case CRITERIA_TYPE_BE_SPELL_TARGET:
+        case CRITERIA_TYPE_BE_SPELL_TARGET2:
+        case CRITERIA_TYPE_CAST_SPELL:
+        case CRITERIA_TYPE_CAST_SPELL2:
+        case CRITERIA_TYPE_LEARN_SPELL:
+        case CRITERIA_TYPE_OWN_ITEM:
+        case CRITERIA_TYPE_USE_ITEM:
+        case CRITERIA_TYPE_LOOT_ITEM:
+        case CRITERIA_TYPE_EQUIP_ITEM:
+        case CRITERIA_TYPE_GAIN_REPUTATION:
+        case CRITERIA_TYPE_DO_EMOTE:
+        case CRITERIA_TYPE_USE_GAMEOBJECT:
+        case CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+        case CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+        case CRITERIA_TYPE_LEARN_SKILL_LINE:
+        case CRITERIA_TYPE_HK_CLASS:
+        case CRITERIA_TYPE_HK_RACE:
+        case CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
+        case CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
+        case CRITERIA_TYPE_CURRENCY:
+        case CRITERIA_TYPE_WIN_ARENA:
+        case CRITERIA_TYPE_PLACE_GARRISON_BUILDING:
+        // checked in the UpdateCriteria switch instead of RequirementsSatisfied
+        case CRITERIA_TYPE_TRANSMOG_SET_UNLOCKED:
+        case CRITERIA_TYPE_APPEARANCE_UNLOCKED_BY_SLOT:
+        case CRITERIA_TYPE_COMPLETE_DUNGEON_ENCOUNTER:
+        case CRITERIA_TYPE_SEND_EVENT_SCENARIO:
+            return true;
+        default:
+            break;
+    }
+
+    return false;
+}
+
 void CriteriaMgr::LoadCriteriaData()
 {
     uint32 oldMSTime = getMSTime();
@@ -306,6 +306,7 @@ protected:
 
     virtual std::string GetOwnerInfo() const = 0;
     virtual CriteriaList const& GetCriteriaByType(CriteriaTypes type) const = 0;
+    virtual CriteriaList const& GetCriteriaByAsset(CriteriaTypes type, uint32 asset) const = 0;
 
     CriteriaProgressMap _criteriaProgress;
     std::map<uint32, uint32 /*ms time left*/> _timeCriteriaTrees;
@@ -342,6 +343,26 @@ public:
         return _questObjectiveCriteriasByType[type];
     }
 
+    CriteriaList const& GetPlayerCriteriaByAsset(CriteriaTypes type, uint32 asset) const
+    {
+        return GetCriteriaByAsset(_criteriasByAsset[type], asset);
+    }
+
+    CriteriaList const& GetGuildCriteriaByAsset(CriteriaTypes type, uint32 asset) const
+    {
+        return GetCriteriaByAsset(_guildCriteriasByAsset[type], asset);
+    }
+
+    CriteriaList const& GetScenarioCriteriaByAsset(CriteriaTypes type, uint32 asset) const
+    {
+        return GetCriteriaByAsset(_scenarioCriteriasByAsset[type], asset);
+    }
+
+    CriteriaList const& GetQuestObjectiveCriteriaByAsset(CriteriaTypes type, uint32 asset) const
+    {
+        return GetCriteriaByAsset(_questObjectiveCriteriasByAsset[type], asset);
+    }
+
     CriteriaTreeList const* GetCriteriaTreesByCriteria(uint32 criteriaId) const
     {
         auto itr = _criteriaTreeByCriteria.find(criteriaId);
@@ -377,6 +398,10 @@ public:
         return false;
     }
 
+    // types for which a non-zero miscValue1 only matches criteria with that Asset, either rejected by RequirementsSatisfied
+    // or skipped in the UpdateCriteria switch (TRANSMOG_SET_UNLOCKED, APPEARANCE_UNLOCKED_BY_SLOT, COMPLETE_DUNGEON_ENCOUNTER, SEND_EVENT_SCENARIO)
+    static bool IsAssetIndexedCriteriaType(CriteriaTypes type);
+
     template<typename Func>
     static void WalkCriteriaTree(CriteriaTree const* tree, Func const& func)
     {
@@ -394,6 +419,14 @@ public:
     ModifierTreeNode const* GetModifierTree(uint32 modifierTreeId) const;
 
 private:
+    typedef std::unordered_map<uint32 /*asset*/, CriteriaList> CriteriaListByAsset;
+
+    CriteriaList const& GetCriteriaByAsset(CriteriaListByAsset const& criteriaByAsset, uint32 asset) const
+    {
+        auto itr = criteriaByAsset.find(asset);
+        return itr != criteriaByAsset.end() ? itr->second : _emptyCriteriaList;
+    }
+
     CriteriaDataMap _criteriaDataMap;
 
     std::unordered_map<uint32, CriteriaTree*> _criteriaTrees;
@@ -408,6 +441,13 @@ private:
     CriteriaList _scenarioCriteriasByType[CRITERIA_TYPE_TOTAL];
     CriteriaList _questObjectiveCriteriasByType[CRITERIA_TYPE_TOTAL];
 
+    // same lists further split by asset for types where the event names it in miscValue1
+    CriteriaListByAsset _criteriasByAsset[CRITERIA_TYPE_TOTAL];
+    CriteriaListByAsset _guildCriteriasByAsset[CRITERIA_TYPE_TOTAL];
+    CriteriaListByAsset _scenarioCriteriasByAsset[CRITERIA_TYPE_TOTAL];
+    CriteriaListByAsset _questObjectiveCriteriasByAsset[CRITERIA_TYPE_TOTAL];
+    CriteriaList const _emptyCriteriaList;
+
     CriteriaList _criteriasByTimedType[CRITERIA_TIMED_TYPE_MAX];
 };
 
@@ -566,6 +566,7 @@ void AuctionHouseObject::AddAuction(AuctionEntry* auction)
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+    AuctionsByItemEntry[auction->itemEntry].push_back(auction);
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
@@ -573,6 +574,21 @@ bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction)
 {
     bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
 
+    auto byEntryItr = AuctionsByItemEntry.find(auction->itemEntry);
+    if (byEntryItr != AuctionsByItemEntry.end())
+    {
+        std::vector<AuctionEntry*>& auctions = byEntryItr->second;
+        auto itr = std::find(auctions.begin(), auctions.end(), auction);
+        if (itr != auctions.end())
+        {
+            *itr = auctions.back();
+            auctions.pop_back();
+        }
+
+        if (auctions.empty())
+            AuctionsByItemEntry.erase(byEntryItr);
+    }
+
     sScriptMgr->OnAuctionRemove(this, auction);
 
     // we need to delete the entry, it is not referenced any more
@@ -669,19 +685,92 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPackets::AuctionHouse::Aucti
     std::wstring const& searchedname, uint32 listfrom, uint8 levelmin, uint8 levelmax, bool usable, Optional<AuctionSearchFilters> const& filters, uint32 quality)
 {
     time_t curTime = sWorld->GetGameTime();
+    LocaleConstant locale = player->GetSession()->GetSessionDbcLocale();
 
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    auto addAuction = [&](AuctionEntry* Aentry, bool nameMatched)
     {
-        AuctionEntry* Aentry = itr->second;
         // Skip expired auctions
         if (Aentry->expire_time < curTime)
-            continue;
+            return;
 
         Item* item = sAuctionMgr->GetAItem(Aentry->itemGUIDLow);
         if (!item)
+            return;
+
+        if (levelmin != 0 && (item->GetRequiredLevel() < levelmin || (levelmax != 0 && item->GetRequiredLevel() > levelmax)))
+            return;
+
+        if (usable && player->CanUseItem(item) != EQUIP_ERR_OK)
+            return;
+
+        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
+        // The base name was already checked for the item entry, only the suffix can still make it match
+        if (!nameMatched)
+        {
+            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
+            //  used in BuildAuctionInfo() which then causes wrong items to be listed
+            int32 propRefID = item->GetItemRandomPropertyId();
+            if (!propRefID)
+                return;
+
+            // Append the suffix to the name (ie: of the Monkey) if one exists
+            // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
+            //  even though the DBC names seem misleading
+
+            const char* suffix = nullptr;
+
+            if (propRefID < 0)
+            {
+                const ItemRandomSuffixEntry* itemRandSuffix = sItemRandomSuffixStore.LookupEntry(-propRefID);
+                if (itemRandSuffix)
+                    suffix = itemRandSuffix->Name->Str[locale];
+            }
+            else
+            {
+                const ItemRandomPropertiesEntry* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
+                if (itemRandProp)
+                    suffix = itemRandProp->Name->Str[locale];
+            }
+
+            // dbc local name
+            if (!suffix)
+                return;
+
+            // Append the suffix (ie: of the Monkey) to the name using localization
+            // or default enUS if localization is invalid
+            std::string name = item->GetTemplate()->GetName(locale);
+            name += ' ';
+            name += suffix;
+
+            // Perform the search with suffix
+            if (!Utf8FitTo(name, searchedname))
+                return;
+        }
+
+        // Add the item if no search term or if entered search term was found
+        if (packet.Items.size() < 50 && packet.TotalCount >= listfrom)
+            Aentry->BuildAuctionInfo(packet.Items, true, item);
+
+        ++packet.TotalCount;
+    };
+
+    // Nothing depends on the item template, walk the auctions directly in id order
+    if (!filters && quality == 0xffffffff && searchedname.empty())
+    {
+        for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+            addAuction(itr->second, true);
+        return;
+    }
+
+    // Evaluate class, quality and name filters once per item entry and keep only the auctions of matching entries
+    std::vector<std::pair<AuctionEntry*, bool /*nameMatched*/>> candidates;
+    for (auto const& entryAuctions : AuctionsByItemEntry)
+    {
+        ItemTemplate const* proto = sObjectMgr->GetItemTemplate(entryAuctions.first);
+        if (!proto)
             continue;
 
-        ItemTemplate const* proto = item->GetTemplate();
         if (filters)
         {
             // if we dont want any class filters, Optional is not initialized
@@ -704,67 +793,29 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPackets::AuctionHouse::Aucti
         if (quality != 0xffffffff && proto->GetQuality() != quality)
             continue;
 
-        if (levelmin != 0 && (item->GetRequiredLevel() < levelmin || (levelmax != 0 && item->GetRequiredLevel() > levelmax)))
-            continue;
-
-        if (usable && player->CanUseItem(item) != EQUIP_ERR_OK)
-            continue;
-
-        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
         // No need to do any of this if no search term was entered
+        bool nameMatched = true;
         if (!searchedname.empty())
         {
-            std::string name = proto->GetName(player->GetSession()->GetSessionDbcLocale());
+            std::string name = proto->GetName(locale);
             if (name.empty())
                 continue;
 
-            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-            int32 propRefID = item->GetItemRandomPropertyId();
-
-            if (propRefID)
-            {
-                // Append the suffix to the name (ie: of the Monkey) if one exists
-                // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
-                //  even though the DBC names seem misleading
-
-                const char* suffix = nullptr;
-
-                if (propRefID < 0)
-                {
-                    const ItemRandomSuffixEntry* itemRandSuffix = sItemRandomSuffixStore.LookupEntry(-propRefID);
-                    if (itemRandSuffix)
-                        suffix = itemRandSuffix->Name->Str[player->GetSession()->GetSessionDbcLocale()];
-                }
-                else
-                {
-                    const ItemRandomPropertiesEntry* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
-                    if (itemRandProp)
-                        suffix = itemRandProp->Name->Str[player->GetSession()->GetSessionDbcLocale()];
-                }
-
-                // dbc local name
-                if (suffix)
-                {
-                    // Append the suffix (ie: of the Monkey) to the name using localization
-                    // or default enUS if localization is invalid
-                    name += ' ';
-                    name += suffix;
-                }
-            }
-
-            // Perform the search (with or without suffix)
-            if (!Utf8FitTo(name, searchedname))
-                continue;
+            nameMatched = Utf8FitTo(name, searchedname);
         }
 
-        // Add the item if no search term or if entered search term was found
-        if (packet.Items.size() < 50 && packet.TotalCount >= listfrom)
-            Aentry->BuildAuctionInfo(packet.Items, true, item);
-
-        ++packet.TotalCount;
+        for (AuctionEntry* Aentry : entryAuctions.second)
+            candidates.emplace_back(Aentry, nameMatched);
     }
+
+    // keep the paging order of a full scan
+    std::sort(candidates.begin(), candidates.end(), [](std::pair<AuctionEntry*, bool> const& left, std::pair<AuctionEntry*, bool> const& right)
+    {
+        return left.first->Id < right.first->Id;
+    });
+
+    for (std::pair<AuctionEntry*, bool> const& candidate : candidates)
+        addAuction(candidate.first, candidate.second);
 }
 
 void AuctionHouseObject::BuildReplicate(WorldPackets::AuctionHouse::AuctionReplicateResponse& auctionReplicateResult, Player* player,
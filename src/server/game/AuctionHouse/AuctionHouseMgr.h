@@ -179,6 +179,9 @@ class TC_GAME_API AuctionHouseObject
   private:
     AuctionEntryMap AuctionsMap;
 
+    // Auctions grouped by item entry so template based search filters are evaluated once per entry
+    std::unordered_map<uint32 /*itemEntry*/, std::vector<AuctionEntry*>> AuctionsByItemEntry;
+
     // Map of throttled players for GetAll, and throttle expiry time
     // Stored here, rather than player object to maintain persistence after logout
     PlayerGetAllThrottleMap GetAllThrottleMap;
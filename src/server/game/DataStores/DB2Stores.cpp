@@ -25,9 +25,11 @@
 #include "ObjectDefines.h"
 #include "ObjectMgr.h"
 #include "Regex.h"
+#include "StartupLoader.h"
 #include "Timer.h"
 #include "Util.h"
 #include <array>
+#include <atomic>
 #include <sstream>
 #include <cctype>
 
@@ -431,8 +433,9 @@ namespace
 
 typedef std::vector<std::string> DB2StoreProblemList;
 
+// stores are loaded concurrently, each one reports its problem into its own slot
 template<class T, template<class> class DB2>
-inline void LoadDB2(uint32& availableDb2Locales, DB2StoreProblemList& errlist, StorageMap& stores, DB2StorageBase* storage, std::string const& db2Path, uint32 defaultLocale, DB2<T> const& /*hint*/)
+inline void LoadDB2(std::atomic<uint32>& availableDb2Locales, std::string& problem, DB2StorageBase* storage, std::string const& db2Path, uint32 defaultLocale, DB2<T> const& /*hint*/)
 {
     // validate structure
     DB2LoadInfo const* loadInfo = storage->GetLoadInfo();
@@ -470,7 +473,7 @@ inline void LoadDB2(uint32& availableDb2Locales, DB2StoreProblemList& errlist, S
 
             if (availableDb2Locales & (1 << i))
                 if (!storage->LoadStringsFrom((db2Path + localeNames[i] + '/'), i))
-                    availableDb2Locales &= ~(1 << i);             // mark as not available for speedup next checks
+                    availableDb2Locales.fetch_and(~(1 << i));     // mark as not available for speedup next checks
 
             storage->LoadStringsFromDB(i);
         }
@@ -483,15 +486,12 @@ inline void LoadDB2(uint32& availableDb2Locales, DB2StoreProblemList& errlist, S
             std::ostringstream stream;
             stream << storage->GetFileName() << " exists, and has " << storage->GetFieldCount() << " field(s) (expected " << loadInfo->Meta->FieldCount
                 << "). Extracted file might be from wrong client version.";
-            std::string buf = stream.str();
-            errlist.push_back(buf);
+            problem = stream.str();
             fclose(f);
         }
         else
-            errlist.push_back(storage->GetFileName());
+            problem = storage->GetFileName();
     }
-
-    stores[storage->GetTableHash()] = storage;
 }
 
 DB2Manager& DB2Manager::Instance()
@@ -500,16 +500,29 @@ DB2Manager& DB2Manager::Instance()
     return instance;
 }
 
-void DB2Manager::LoadStores(std::string const& dataPath, uint32 defaultLocale)
+void DB2Manager::LoadStores(std::string const& dataPath, uint32 defaultLocale, uint32 loaderThreads)
 {
     uint32 oldMSTime = getMSTime();
 
     std::string db2Path = dataPath + "dbc/";
 
-    DB2StoreProblemList bad_db2_files;
-    uint32 availableDb2Locales = 0xFF;
+    std::atomic<uint32> availableDb2Locales(0xFF);
+    std::vector<DB2StorageBase*> storages;
+    DB2StoreProblemList problems;
+    StartupLoader loader("DB2 stores");
+
+    // every store only depends on its own file and hotfix tables
+    auto loadDB2 = [&](auto& store)
+    {
+        std::size_t index = storages.size();
+        storages.push_back(&store);
+        loader.Add(store.GetFileName(), [&, index, storage = &store]()
+        {
+            LoadDB2(availableDb2Locales, problems[index], storage, db2Path, defaultLocale, *storage);
+        });
+    };
 
-#define LOAD_DB2(store) LoadDB2(availableDb2Locales, bad_db2_files, _stores, &store, db2Path, defaultLocale, store)
+#define LOAD_DB2(store) loadDB2(store)
 
     LOAD_DB2(sAchievementStore);
     LOAD_DB2(sAdventureJournalStore);
@@ -770,6 +783,18 @@ void DB2Manager::LoadStores(std::string const& dataPath, uint32 defaultLocale)
 
 #undef LOAD_DB2
 
+    problems.resize(storages.size());
+    loader.Run(loaderThreads);
+
+    DB2StoreProblemList bad_db2_files;
+    for (std::size_t i = 0; i < storages.size(); ++i)
+    {
+        if (!problems[i].empty())
+            bad_db2_files.push_back(std::move(problems[i]));
+
+        _stores[storages[i]->GetTableHash()] = storages[i];
+    }
+
     for (AreaGroupMemberEntry const* areaGroupMember : sAreaGroupMemberStore)
         _areaGroupMembers[areaGroupMember->AreaGroupID].push_back(areaGroupMember->AreaID);
 
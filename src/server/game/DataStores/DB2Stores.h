@@ -277,7 +277,7 @@ public:
 
     static DB2Manager& Instance();
 
-    void LoadStores(std::string const& dataPath, uint32 defaultLocale);
+    void LoadStores(std::string const& dataPath, uint32 defaultLocale, uint32 loaderThreads);
     DB2StorageBase const* GetStorage(uint32 type) const;
 
     void LoadHotfixData();
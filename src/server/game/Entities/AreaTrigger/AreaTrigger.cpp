@@ -64,7 +64,7 @@ void AreaTrigger::AddToWorld()
     ///- Register the AreaTrigger for guid lookup and for caster
     if (!IsInWorld())
     {
-        GetMap()->GetObjectsStore().Insert<AreaTrigger>(GetGUID(), this);
+        GetMap()->AddToObjectsStore<AreaTrigger>(GetGUID(), this);
         WorldObject::AddToWorld();
     }
 }
@@ -86,7 +86,7 @@ void AreaTrigger::RemoveFromWorld()
             _ai->OnRemove();
 
         WorldObject::RemoveFromWorld();
-        GetMap()->GetObjectsStore().Remove<AreaTrigger>(GetGUID());
+        GetMap()->RemoveFromObjectsStore<AreaTrigger>(GetGUID());
     }
 }
 
@@ -45,7 +45,7 @@ void Conversation::AddToWorld()
     ///- Register the Conversation for guid lookup and for caster
     if (!IsInWorld())
     {
-        GetMap()->GetObjectsStore().Insert<Conversation>(GetGUID(), this);
+        GetMap()->AddToObjectsStore<Conversation>(GetGUID(), this);
         WorldObject::AddToWorld();
     }
 }
@@ -56,7 +56,7 @@ void Conversation::RemoveFromWorld()
     if (IsInWorld())
     {
         WorldObject::RemoveFromWorld();
-        GetMap()->GetObjectsStore().Remove<Conversation>(GetGUID());
+        GetMap()->RemoveFromObjectsStore<Conversation>(GetGUID());
     }
 }
 
@@ -141,6 +141,7 @@ bool Conversation::Create(ObjectGuid::LowType lowGuid, uint32 conversationEntry,
         if (!actorGuid)
             continue;
 
+        std::shared_lock<std::shared_timed_mutex> lock = map->LockSpawnIdStoresForRead();
         for (auto const& pair : Trinity::Containers::MapEqualRange(map->GetCreatureBySpawnIdStore(), actorGuid))
         {
             // we just need the last one, overriding is legit
@@ -50,7 +50,7 @@ void Corpse::AddToWorld()
 {
     ///- Register the corpse for guid lookup
     if (!IsInWorld())
-        GetMap()->GetObjectsStore().Insert<Corpse>(GetGUID(), this);
+        GetMap()->AddToObjectsStore<Corpse>(GetGUID(), this);
 
     Object::AddToWorld();
 }
@@ -59,7 +59,7 @@ void Corpse::RemoveFromWorld()
 {
     ///- Remove the corpse from the accessor
     if (IsInWorld())
-        GetMap()->GetObjectsStore().Remove<Corpse>(GetGUID());
+        GetMap()->RemoveFromObjectsStore<Corpse>(GetGUID());
 
     WorldObject::RemoveFromWorld();
 }
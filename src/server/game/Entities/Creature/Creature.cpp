@@ -235,9 +235,9 @@ void Creature::AddToWorld()
         if (GetZoneScript())
             GetZoneScript()->OnCreatureCreate(this);
 
-        GetMap()->GetObjectsStore().Insert<Creature>(GetGUID(), this);
+        GetMap()->AddToObjectsStore<Creature>(GetGUID(), this);
         if (m_spawnId)
-            GetMap()->GetCreatureBySpawnIdStore().insert(std::make_pair(m_spawnId, this));
+            GetMap()->AddToSpawnIdStore(m_spawnId, this);
 
         Unit::AddToWorld();
         SearchFormation();
@@ -260,8 +260,8 @@ void Creature::RemoveFromWorld()
         Unit::RemoveFromWorld();
 
         if (m_spawnId)
-            Trinity::Containers::MultimapErasePair(GetMap()->GetCreatureBySpawnIdStore(), m_spawnId, this);
-        GetMap()->GetObjectsStore().Remove<Creature>(GetGUID());
+            GetMap()->RemoveFromSpawnIdStore(m_spawnId, this);
+        GetMap()->RemoveFromObjectsStore<Creature>(GetGUID());
     }
 }
 
@@ -1523,11 +1523,11 @@ bool Creature::LoadCreatureFromDB(ObjectGuid::LowType spawnId, Map* map, bool ad
     {
         // If an alive instance of this spawnId is already found, skip creation
         // If only dead instance(s) exist, despawn them and spawn a new (maybe also dead) version
-        const auto creatureBounds = map->GetCreatureBySpawnIdStore().equal_range(spawnId);
         std::vector <Creature*> despawnList;
-
-        if (creatureBounds.first != creatureBounds.second)
         {
+            // released before despawning, removal takes the store lock for writing
+            std::shared_lock<std::shared_timed_mutex> lock = map->LockSpawnIdStoresForRead();
+            const auto creatureBounds = map->GetCreatureBySpawnIdStore().equal_range(spawnId);
             for (auto itr = creatureBounds.first; itr != creatureBounds.second; ++itr)
             {
                 if (itr->second->IsAlive())
@@ -1541,12 +1541,10 @@ bool Creature::LoadCreatureFromDB(ObjectGuid::LowType spawnId, Map* map, bool ad
                     TC_LOG_DEBUG("maps", "Despawned dead instance of spawn " UI64FMTD " (%s)", spawnId, itr->second->GetGUID().ToString().c_str());
                 }
             }
-
-            for (Creature* despawnCreature : despawnList)
-            {
-                despawnCreature->AddObjectToRemoveList();
-            }
         }
+
+        for (Creature* despawnCreature : despawnList)
+            despawnCreature->AddObjectToRemoveList();
     }
 
     CreatureData const* data = sObjectMgr->GetCreatureData(spawnId);
@@ -2259,10 +2257,26 @@ void Creature::CallAssistance()
         if (radius > 0)
         {
             std::list<Creature*> assistList;
-            Trinity::AnyAssistCreatureInRangeCheck u_check(this, GetVictim(), radius);
+            // line of sight is checked below for all helpers at once
+            Trinity::AnyAssistCreatureInRangeCheck u_check(this, GetVictim(), radius, false);
             Trinity::CreatureListSearcher<Trinity::AnyAssistCreatureInRangeCheck> searcher(this, assistList, u_check);
             Cell::VisitGridObjects(this, searcher, radius);
 
+            if (!assistList.empty() && !(IsAIEnabled && AI()->CanTargetOutOfLOS()))
+            {
+                std::list<Creature*> outOfLOSAllowed;
+                for (auto itr = assistList.begin(); itr != assistList.end();)
+                {
+                    auto next = std::next(itr);
+                    if ((*itr)->IsAIEnabled && (*itr)->AI()->CanBeTargetedOutOfLOS())
+                        outOfLOSAllowed.splice(outOfLOSAllowed.end(), assistList, itr);
+                    itr = next;
+                }
+
+                RemoveUnitsOutOfLOS(assistList, *this);
+                assistList.splice(assistList.end(), outOfLOSAllowed);
+            }
+
             if (!assistList.empty())
             {
                 AssistDelayEvent* e = new AssistDelayEvent(EnsureVictim()->GetGUID(), *this);
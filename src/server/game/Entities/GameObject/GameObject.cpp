@@ -164,9 +164,9 @@ void GameObject::AddToWorld()
         if (m_zoneScript)
             m_zoneScript->OnGameObjectCreate(this);
 
-        GetMap()->GetObjectsStore().Insert<GameObject>(GetGUID(), this);
+        GetMap()->AddToObjectsStore<GameObject>(GetGUID(), this);
         if (m_spawnId)
-            GetMap()->GetGameObjectBySpawnIdStore().insert(std::make_pair(m_spawnId, this));
+            GetMap()->AddToSpawnIdStore(m_spawnId, this);
 
         // The state can be changed after GameObject::Create but before GameObject::AddToWorld
         bool toggledState = GetGoType() == GAMEOBJECT_TYPE_CHEST ? getLootState() == GO_READY : (GetGoState() == GO_STATE_READY || IsTransport());
@@ -199,8 +199,8 @@ void GameObject::RemoveFromWorld()
         WorldObject::RemoveFromWorld();
 
         if (m_spawnId)
-            Trinity::Containers::MultimapErasePair(GetMap()->GetGameObjectBySpawnIdStore(), m_spawnId, this);
-        GetMap()->GetObjectsStore().Remove<GameObject>(GetGUID());
+            GetMap()->RemoveFromSpawnIdStore(m_spawnId, this);
+        GetMap()->RemoveFromObjectsStore<GameObject>(GetGUID());
     }
 }
 
@@ -2440,6 +2440,9 @@ void GameObject::EnableCollision(bool enable)
         GetMap()->InsertGameObjectModel(*m_model);*/
 
     m_model->enableCollision(enable);
+
+    if (IsInWorld())
+        GetMap()->GameObjectCollisionChanged();
 }
 
 void GameObject::UpdateModel()
@@ -2520,6 +2523,76 @@ GameObject* GameObject::GetLinkedTrap()
     return ObjectAccessor::GetGameObject(*this, m_linkedTrap);
 }
 
+uint32 GameObject::GetObserverDependentUpdateFieldValue(uint16 index, Player* target) const
+{
+    if (index == OBJECT_DYNAMIC_FLAGS)
+    {
+        uint16 dynFlags = 0;
+        int16 pathProgress = -1;
+        switch (GetGoType())
+        {
+            case GAMEOBJECT_TYPE_QUESTGIVER:
+                if (ActivateToQuest(target))
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                break;
+            case GAMEOBJECT_TYPE_CHEST:
+            case GAMEOBJECT_TYPE_GOOBER:
+                if (ActivateToQuest(target))
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                else if (target->IsGameMaster())
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                break;
+            case GAMEOBJECT_TYPE_GENERIC:
+                if (ActivateToQuest(target))
+                    dynFlags |= GO_DYNFLAG_LO_SPARKLE;
+                break;
+            case GAMEOBJECT_TYPE_TRANSPORT:
+            case GAMEOBJECT_TYPE_MAP_OBJ_TRANSPORT:
+            {
+                if (uint32 transportPeriod = GetTransportPeriod())
+                {
+                    float timer = float(m_goValue.Transport.PathProgress % transportPeriod);
+                    pathProgress = int16(timer / float(transportPeriod) * 65535.0f);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+
+        // low half is dynamic flags, high half is path progress - same bytes as writing them separately
+        return uint32(dynFlags) | uint32(uint16(pathProgress)) << 16;
+    }
+
+    if (index == GAMEOBJECT_FLAGS)
+    {
+        uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
+        if (GetGoType() == GAMEOBJECT_TYPE_CHEST)
+            if (GetGOInfo()->chest.usegrouplootrules && !IsLootAllowedFor(target))
+                goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
+
+        return goFlags;
+    }
+
+    return m_uint32Values[index];
+}
+
+bool GameObject::BuildValuesUpdateCacheKey(Player* target, std::vector<uint32>& key) const
+{
+    if (!WorldObject::BuildValuesUpdateCacheKey(target, key))
+        return false;
+
+    // only the fields written in this values update, the same ones for every observer
+    if (_changesMask[OBJECT_DYNAMIC_FLAGS] || (GameObjectUpdateFieldFlags[OBJECT_DYNAMIC_FLAGS] & _fieldNotifyFlags))
+        key.push_back(GetObserverDependentUpdateFieldValue(OBJECT_DYNAMIC_FLAGS, target));
+
+    bool forcedFlags = GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo()->chest.usegrouplootrules && HasLootRecipient();
+    if (_changesMask[GAMEOBJECT_FLAGS] || (GameObjectUpdateFieldFlags[GAMEOBJECT_FLAGS] & _fieldNotifyFlags) || forcedFlags)
+        key.push_back(GetObserverDependentUpdateFieldValue(GAMEOBJECT_FLAGS, target));
+
+    return true;
+}
+
 void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) const
 {
     if (!target)
@@ -2527,7 +2600,6 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
 
     bool isStoppableTransport = GetGoType() == GAMEOBJECT_TYPE_TRANSPORT && !m_goValue.Transport.StopFrames->empty();
     bool forcedFlags = GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo()->chest.usegrouplootrules && HasLootRecipient();
-    bool targetIsGM = target->IsGameMaster();
 
     std::size_t blockCount = UpdateMask::GetBlockCount(m_valuesCount);
 
@@ -2540,61 +2612,27 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
     std::size_t maskPos = data->wpos();
     data->resize(data->size() + blockCount * sizeof(UpdateMask::BlockType));
 
+    uint32 const* groupFlags = GetUpdateFieldGroupFlags(flags);
+
     for (uint16 index = 0; index < m_valuesCount; ++index)
     {
+        // skip groups of unchanged fields that are not forced by notify flags at once
+        if (updateType == UPDATETYPE_VALUES && !(index % UPDATE_FIELDS_PER_GROUP) && index + UPDATE_FIELDS_PER_GROUP <= m_valuesCount &&
+            !(groupFlags[index / UPDATE_FIELDS_PER_GROUP] & _fieldNotifyFlags) && IsUpdateFieldGroupUnchanged(_changesMask.data(), index) &&
+            (!forcedFlags || GAMEOBJECT_FLAGS / UPDATE_FIELDS_PER_GROUP != index / UPDATE_FIELDS_PER_GROUP))
+        {
+            index += UPDATE_FIELDS_PER_GROUP - 1;
+            continue;
+        }
+
         if (_fieldNotifyFlags & flags[index] ||
             ((updateType == UPDATETYPE_VALUES ? _changesMask[index] : m_uint32Values[index]) && (flags[index] & visibleFlag)) ||
             (index == GAMEOBJECT_FLAGS && forcedFlags))
         {
             UpdateMask::SetUpdateBit(data->contents() + maskPos, index);
 
-            if (index == OBJECT_DYNAMIC_FLAGS)
-            {
-                uint16 dynFlags = 0;
-                int16 pathProgress = -1;
-                switch (GetGoType())
-                {
-                    case GAMEOBJECT_TYPE_QUESTGIVER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_CHEST:
-                    case GAMEOBJECT_TYPE_GOOBER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
-                        else if (targetIsGM)
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_GENERIC:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_SPARKLE;
-                        break;
-                    case GAMEOBJECT_TYPE_TRANSPORT:
-                    case GAMEOBJECT_TYPE_MAP_OBJ_TRANSPORT:
-                    {
-                        if (uint32 transportPeriod = GetTransportPeriod())
-                        {
-                            float timer = float(m_goValue.Transport.PathProgress % transportPeriod);
-                            pathProgress = int16(timer / float(transportPeriod) * 65535.0f);
-                        }
-                        break;
-                    }
-                    default:
-                        break;
-                }
-
-                *data << uint16(dynFlags);
-                *data << int16(pathProgress);
-            }
-            else if (index == GAMEOBJECT_FLAGS)
-            {
-                uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
-                if (GetGoType() == GAMEOBJECT_TYPE_CHEST)
-                    if (GetGOInfo()->chest.usegrouplootrules && !IsLootAllowedFor(target))
-                        goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
-
-                *data << goFlags;
-            }
+            if (index == OBJECT_DYNAMIC_FLAGS || index == GAMEOBJECT_FLAGS)
+                *data << GetObserverDependentUpdateFieldValue(index, target);
             else if (index == GAMEOBJECT_LEVEL)
             {
                 if (isStoppableTransport)
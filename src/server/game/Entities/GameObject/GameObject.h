@@ -87,6 +87,8 @@ class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>
         ~GameObject();
 
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+        bool BuildValuesUpdateCacheKey(Player* target, std::vector<uint32>& key) const override;
+        uint32 GetObserverDependentUpdateFieldValue(uint16 index, Player* target) const;
 
         void AddToWorld() override;
         void RemoveFromWorld() override;
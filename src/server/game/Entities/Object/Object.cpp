@@ -69,6 +69,7 @@ Object::Object()
 
     m_inWorld           = false;
     m_objectUpdated     = false;
+    _updateObjectIndex  = UPDATE_OBJECT_INDEX_NONE;
 }
 
 WorldObject::~WorldObject()
@@ -821,12 +822,22 @@ void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
     uint32 visibleFlag = GetUpdateFieldData(target, flags);
     ASSERT(flags);
 
+    uint32 const* groupFlags = GetUpdateFieldGroupFlags(flags);
+
     *data << uint8(blockCount);
     std::size_t maskPos = data->wpos();
     data->resize(data->size() + blockCount * sizeof(UpdateMask::BlockType));
 
     for (uint16 index = 0; index < m_valuesCount; ++index)
     {
+        // skip groups of unchanged fields that are not forced by notify flags at once
+        if (updateType == UPDATETYPE_VALUES && groupFlags && !(index % UPDATE_FIELDS_PER_GROUP) && index + UPDATE_FIELDS_PER_GROUP <= m_valuesCount &&
+            !(groupFlags[index / UPDATE_FIELDS_PER_GROUP] & _fieldNotifyFlags) && IsUpdateFieldGroupUnchanged(_changesMask.data(), index))
+        {
+            index += UPDATE_FIELDS_PER_GROUP - 1;
+            continue;
+        }
+
         if (_fieldNotifyFlags & flags[index] ||
             ((updateType == UPDATETYPE_VALUES ? _changesMask[index] : m_uint32Values[index]) && (flags[index] & visibleFlag)))
         {
@@ -901,7 +912,7 @@ void Object::ClearUpdateMask(bool remove)
     }
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, ValuesUpdateCache* cache /*= nullptr*/) const
 {
     UpdateDataMapType::iterator iter = data_map.find(player);
 
@@ -912,7 +923,35 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    if (!cache || !BuildValuesUpdateCacheKey(player, cache->NewKey()))
+    {
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+        return;
+    }
+
+    // another observer with the same visibility already got this block
+    if (ByteBuffer const* block = cache->Find())
+    {
+        iter->second.AddUpdateBlock(*block);
+        return;
+    }
+
+    ByteBuffer& block = cache->Insert();
+    block << uint8(UPDATETYPE_VALUES);
+    block << GetGUID();
+
+    BuildValuesUpdate(UPDATETYPE_VALUES, &block, player);
+    BuildDynamicValuesUpdate(UPDATETYPE_VALUES, &block, player);
+
+    iter->second.AddUpdateBlock(block);
+}
+
+bool Object::BuildValuesUpdateCacheKey(Player* target, std::vector<uint32>& key) const
+{
+    uint32* flags = nullptr;
+    key.push_back(GetUpdateFieldData(target, flags));
+    key.push_back(GetDynamicUpdateFieldData(target, flags));
+    return true;
 }
 
 uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
@@ -1531,7 +1570,7 @@ void MovementInfo::OutDebug()
 }
 
 WorldObject::WorldObject(bool isWorldObject) : WorldLocation(), LastUsedScriptID(0),
-m_name(""), m_isActive(false), m_isWorldObject(isWorldObject), m_zoneScript(NULL),
+m_name(""), m_isActive(false), m_isWorldObject(isWorldObject), m_isInRemoveList(false), m_zoneScript(NULL),
 m_transport(NULL), m_currMap(NULL), m_InstanceId(0),
 _dbPhase(0), m_visibleBySummonerOnly(false), m_notifyflags(0), m_executed_notifies(0)
 {
@@ -1821,6 +1860,47 @@ void WorldObject::GetHitSpherePointFor(Position const& dest, float& x, float& y,
     z = pos.GetPositionZ();
 }
 
+template <class T>
+void WorldObject::RemoveUnitsOutOfLOS(std::list<T*>& objects, Position const& pos) const
+{
+    if (!IsInWorld())
+        return;
+
+    // same end points as IsWithinLOS called on each unit
+    std::vector<G3D::Vector3> points;
+    points.reserve(objects.size());
+    for (T* object : objects)
+    {
+        Unit* unit = object->ToUnit();
+        if (!unit || !unit->IsInWorld())
+            continue;
+
+        float x, y, z;
+        if (unit->GetTypeId() == TYPEID_PLAYER)
+            unit->GetPosition(x, y, z);
+        else
+            unit->GetHitSpherePointFor(pos, x, y, z);
+
+        points.emplace_back(x, y, z + 2.0f);
+    }
+
+    if (points.empty())
+        return;
+
+    std::unique_ptr<bool[]> inLOS(new bool[points.size()]);
+    GetMap()->isInLineOfSight(GetPhaseShift(), pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ() + 2.0f, points.data(), uint32(points.size()), inLOS.get());
+
+    uint32 index = 0;
+    for (auto itr = objects.begin(); itr != objects.end();)
+    {
+        Unit* unit = (*itr)->ToUnit();
+        if (unit && unit->IsInWorld() && !inLOS[index++])
+            itr = objects.erase(itr);
+        else
+            ++itr;
+    }
+}
+
 bool WorldObject::GetDistanceOrder(WorldObject const* obj1, WorldObject const* obj2, bool is3D /* = true */) const
 {
     float dx1 = GetPositionX() - obj1->GetPositionX();
@@ -3268,6 +3348,7 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
     GuidSet plr_list;
+    ValuesUpdateCache i_valuesUpdateCache;
     WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj) { }
     void Visit(PlayerMapType &m)
     {
@@ -3325,7 +3406,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (plr_list.find(player->GetGUID()) == plr_list.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, &i_valuesUpdateCache);
             plr_list.insert(player->GetGUID());
         }
     }
@@ -3338,6 +3419,7 @@ void WorldObject::BuildUpdate(UpdateDataMapType& data_map)
     WorldObjectChangeAccumulator notifier(*this, data_map);
     //we must build packets for all visible players
     Cell::VisitWorldObjects(this, notifier, GetVisibilityRange());
+    GetMap()->AddValuesUpdateBlockCounts(notifier.i_valuesUpdateCache.GetBuiltCount(), notifier.i_valuesUpdateCache.GetSharedCount());
 
     ClearUpdateMask(false);
 }
@@ -3374,3 +3456,6 @@ template TC_GAME_API void WorldObject::GetCreatureListInGrid(std::vector<Creatur
 template TC_GAME_API void WorldObject::GetPlayerListInGrid(std::list<Player*>&, float) const;
 template TC_GAME_API void WorldObject::GetPlayerListInGrid(std::deque<Player*>&, float) const;
 template TC_GAME_API void WorldObject::GetPlayerListInGrid(std::vector<Player*>&, float) const;
+
+template TC_GAME_API void WorldObject::RemoveUnitsOutOfLOS(std::list<WorldObject*>&, Position const&) const;
+template TC_GAME_API void WorldObject::RemoveUnitsOutOfLOS(std::list<Creature*>&, Position const&) const;
@@ -49,6 +49,7 @@ class TempSummon;
 class Transport;
 class Unit;
 class UpdateData;
+class ValuesUpdateCache;
 class WorldObject;
 class WorldPacket;
 class ZoneScript;
@@ -250,7 +251,11 @@ class TC_GAME_API Object
         virtual bool hasQuest(uint32 /* quest_id */) const { return false; }
         virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
         virtual void BuildUpdate(UpdateDataMapType&) { }
-        void BuildFieldsUpdate(Player*, UpdateDataMapType &) const;
+        void BuildFieldsUpdate(Player*, UpdateDataMapType &, ValuesUpdateCache* cache = nullptr) const;
+
+        // position in Map::_updateObjects while the object waits for its update to be sent
+        uint32 GetUpdateObjectIndex() const { return _updateObjectIndex; }
+        void SetUpdateObjectIndex(uint32 index) { _updateObjectIndex = index; }
 
         void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
         void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= uint16(~flag); }
@@ -309,6 +314,10 @@ class TC_GAME_API Object
         virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
         virtual void BuildDynamicValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
 
+        // Appends everything besides the object itself that the values update block for target depends on.
+        // Returns false if the block can not be shared with other observers.
+        virtual bool BuildValuesUpdateCacheKey(Player* target, std::vector<uint32>& key) const;
+
         uint16 m_objectType;
 
         TypeID m_objectTypeId;
@@ -340,6 +349,7 @@ class TC_GAME_API Object
 
     private:
         bool m_inWorld;
+        uint32 _updateObjectIndex;
 
         // for output helpfull error messages from asserts
         bool PrintIndexError(uint32 index, bool set) const;
@@ -472,6 +482,9 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         bool IsWithinDistInMap(WorldObject const* obj, float dist2compare, bool is3D = true) const;
         bool IsWithinLOS(float x, float y, float z) const;
         bool IsWithinLOSInMap(WorldObject const* obj) const;
+        // IsWithinLOS(pos) of every unit in objects, with all rays cast together
+        template <class T>
+        void RemoveUnitsOutOfLOS(std::list<T*>& objects, Position const& pos) const;
         Position GetHitSpherePointFor(Position const& dest) const;
         void GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z) const;
         bool GetDistanceOrder(WorldObject const* obj1, WorldObject const* obj2, bool is3D = true) const;
@@ -598,6 +611,8 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         void setActive(bool isActiveObject);
         void SetWorldObject(bool apply);
         bool IsPermanentWorldObject() const { return m_isWorldObject; }
+        bool IsInRemoveList() const { return m_isInRemoveList; }
+        void SetInRemoveList(bool apply) { m_isInRemoveList = apply; }
         bool IsWorldObject() const;
 
         uint32  LastUsedScriptID;
@@ -629,6 +644,7 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         std::string m_name;
         bool m_isActive;
         const bool m_isWorldObject;
+        bool m_isInRemoveList;
 
         Area*       m_area;
         ZoneScript* m_zoneScript;
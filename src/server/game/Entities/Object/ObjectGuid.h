@@ -20,6 +20,7 @@
 #define ObjectGuid_h__
 
 #include "Define.h"
+#include <atomic>
 #include <deque>
 #include <functional>
 #include <list>
@@ -350,13 +351,13 @@ class TC_GAME_API ObjectGuidGeneratorBase
 public:
     ObjectGuidGeneratorBase(ObjectGuid::LowType start = UI64LIT(1)) : _nextGuid(start) { }
 
-    virtual void Set(uint64 val) { _nextGuid = val; }
+    virtual void Set(uint64 val) { _nextGuid.store(val); }
     virtual ObjectGuid::LowType Generate() = 0;
-    ObjectGuid::LowType GetNextAfterMaxUsed() const { return _nextGuid; }
+    ObjectGuid::LowType GetNextAfterMaxUsed() const { return _nextGuid.load(); }
 
 protected:
     static void HandleCounterOverflow(HighGuid high);
-    uint64 _nextGuid;
+    std::atomic<uint64> _nextGuid;
 };
 
 template<HighGuid high>
@@ -367,9 +368,10 @@ public:
 
     ObjectGuid::LowType Generate() override
     {
-        if (_nextGuid >= ObjectGuid::GetMaxCounter(high) - 1)
+        uint64 guid = _nextGuid++;
+        if (guid >= ObjectGuid::GetMaxCounter(high) - 1)
             HandleCounterOverflow(high);
-        return _nextGuid++;
+        return guid;
     }
 };
 
@@ -23,6 +23,7 @@
 #include "ByteBuffer.h"
 #include "ObjectGuid.h"
 #include <set>
+#include <vector>
 
 class WorldPacket;
 
@@ -57,6 +58,44 @@ enum OBJECT_UPDATE_FLAGS
     //UPDATEFLAG_SCENE_PENDING_INSTANCE = 0x20000
 };
 
+// Values update blocks of a single object built during one BuildUpdate pass. Observers that produce the same
+// key (see Object::BuildValuesUpdateCacheKey) receive the same bytes, so the block is serialized only once for them.
+class ValuesUpdateCache
+{
+    public:
+        ValuesUpdateCache() : _sharedCount(0) { }
+
+        std::vector<uint32>& NewKey() { _key.clear(); return _key; }
+
+        ByteBuffer const* Find()
+        {
+            for (std::pair<std::vector<uint32>, ByteBuffer> const& block : _blocks)
+            {
+                if (block.first == _key)
+                {
+                    ++_sharedCount;
+                    return &block.second;
+                }
+            }
+
+            return nullptr;
+        }
+
+        ByteBuffer& Insert()
+        {
+            _blocks.emplace_back(_key, ByteBuffer(500));
+            return _blocks.back().second;
+        }
+
+        uint32 GetBuiltCount() const { return uint32(_blocks.size()); }
+        uint32 GetSharedCount() const { return _sharedCount; }
+
+    private:
+        std::vector<uint32> _key;
+        uint32 _sharedCount;
+        std::vector<std::pair<std::vector<uint32>, ByteBuffer>> _blocks;
+};
+
 class UpdateData
 {
     public:
@@ -5119,3 +5119,49 @@ uint32 ConversationDynamicUpdateFieldFlags[CONVERSATION_DYNAMIC_END] =
     UF_FLAG_PUBLIC,                                         // CONVERSATION_DYNAMIC_FIELD_ACTORS
     UF_FLAG_0x100,                                          // CONVERSATION_DYNAMIC_FIELD_LINES
 };
+
+namespace
+{
+    template<std::size_t FieldCount>
+    struct UpdateFieldGroupFlags
+    {
+        explicit UpdateFieldGroupFlags(uint32 const (&flags)[FieldCount]) : Groups()
+        {
+            for (std::size_t i = 0; i < FieldCount; ++i)
+                Groups[i / UPDATE_FIELDS_PER_GROUP] |= flags[i];
+        }
+
+        uint32 Groups[(FieldCount + UPDATE_FIELDS_PER_GROUP - 1) / UPDATE_FIELDS_PER_GROUP];
+    };
+
+    UpdateFieldGroupFlags<CONTAINER_END> const ItemUpdateFieldGroupFlags(ItemUpdateFieldFlags);
+    UpdateFieldGroupFlags<PLAYER_END> const UnitUpdateFieldGroupFlags(UnitUpdateFieldFlags);
+    UpdateFieldGroupFlags<GAMEOBJECT_END> const GameObjectUpdateFieldGroupFlags(GameObjectUpdateFieldFlags);
+    UpdateFieldGroupFlags<DYNAMICOBJECT_END> const DynamicObjectUpdateFieldGroupFlags(DynamicObjectUpdateFieldFlags);
+    UpdateFieldGroupFlags<CORPSE_END> const CorpseUpdateFieldGroupFlags(CorpseUpdateFieldFlags);
+    UpdateFieldGroupFlags<AREATRIGGER_END> const AreaTriggerUpdateFieldGroupFlags(AreaTriggerUpdateFieldFlags);
+    UpdateFieldGroupFlags<SCENEOBJECT_END> const SceneObjectUpdateFieldGroupFlags(SceneObjectUpdateFieldFlags);
+    UpdateFieldGroupFlags<CONVERSATION_END> const ConversationUpdateFieldGroupFlags(ConversationUpdateFieldFlags);
+}
+
+uint32 const* GetUpdateFieldGroupFlags(uint32 const* flags)
+{
+    if (flags == ItemUpdateFieldFlags)
+        return ItemUpdateFieldGroupFlags.Groups;
+    if (flags == UnitUpdateFieldFlags)
+        return UnitUpdateFieldGroupFlags.Groups;
+    if (flags == GameObjectUpdateFieldFlags)
+        return GameObjectUpdateFieldGroupFlags.Groups;
+    if (flags == DynamicObjectUpdateFieldFlags)
+        return DynamicObjectUpdateFieldGroupFlags.Groups;
+    if (flags == CorpseUpdateFieldFlags)
+        return CorpseUpdateFieldGroupFlags.Groups;
+    if (flags == AreaTriggerUpdateFieldFlags)
+        return AreaTriggerUpdateFieldGroupFlags.Groups;
+    if (flags == SceneObjectUpdateFieldFlags)
+        return SceneObjectUpdateFieldGroupFlags.Groups;
+    if (flags == ConversationUpdateFieldFlags)
+        return ConversationUpdateFieldGroupFlags.Groups;
+
+    return nullptr;
+}
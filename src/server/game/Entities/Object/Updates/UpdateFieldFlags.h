@@ -20,6 +20,10 @@
 
 #include "UpdateFields.h"
 #include "Define.h"
+#include <cstring>
+
+// Number of fields tested at once when looking for changed fields (changes masks store one byte per field)
+#define UPDATE_FIELDS_PER_GROUP 8
 
 enum UpdatefieldFlags
 {
@@ -50,4 +54,16 @@ TC_GAME_API extern uint32 SceneObjectUpdateFieldFlags[SCENEOBJECT_END];
 TC_GAME_API extern uint32 ConversationUpdateFieldFlags[CONVERSATION_END];
 TC_GAME_API extern uint32 ConversationDynamicUpdateFieldFlags[CONVERSATION_DYNAMIC_END];
 
+// Union of the flags of every UPDATE_FIELDS_PER_GROUP consecutive fields of one of the tables above
+TC_GAME_API uint32 const* GetUpdateFieldGroupFlags(uint32 const* flags);
+
+inline bool IsUpdateFieldGroupUnchanged(uint8 const* changesMask, std::size_t index)
+{
+    static_assert(UPDATE_FIELDS_PER_GROUP == sizeof(uint64), "A field group must be tested with a single load");
+
+    uint64 group;
+    memcpy(&group, changesMask + index, sizeof(group));
+    return !group;
+}
+
 #endif // _UPDATEFIELDFLAGS_H
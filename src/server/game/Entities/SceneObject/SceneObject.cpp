@@ -45,7 +45,7 @@ void SceneObject::AddToWorld()
     ///- Register the Scene for guid lookup and for caster
     if (!IsInWorld())
     {
-        GetMap()->GetObjectsStore().Insert<SceneObject>(GetGUID(), this);
+        GetMap()->AddToObjectsStore<SceneObject>(GetGUID(), this);
         WorldObject::AddToWorld();
     }
 }
@@ -56,7 +56,7 @@ void SceneObject::RemoveFromWorld()
     if (IsInWorld())
     {
         WorldObject::RemoveFromWorld();
-        GetMap()->GetObjectsStore().Remove<SceneObject>(GetGUID());
+        GetMap()->RemoveFromObjectsStore<SceneObject>(GetGUID());
     }
 }
 
@@ -757,8 +757,10 @@ void Transport::BuildUpdate(UpdateDataMapType& data_map)
     if (players.isEmpty())
         return;
 
+    ValuesUpdateCache valuesUpdateCache;
     for (Map::PlayerList::const_iterator itr = players.begin(); itr != players.end(); ++itr)
-        BuildFieldsUpdate(itr->GetSource(), data_map);
+        BuildFieldsUpdate(itr->GetSource(), data_map, &valuesUpdateCache);
 
+    GetMap()->AddValuesUpdateBlockCounts(valuesUpdateCache.GetBuiltCount(), valuesUpdateCache.GetSharedCount());
     ClearUpdateMask(true);
 }
@@ -44,6 +44,7 @@
 #include "Log.h"
 #include "LootMgr.h"
 #include "LootPackets.h"
+#include "Map.h"
 #include "MiscPackets.h"
 #include "MotionMaster.h"
 #include "MovementPackets.h"
@@ -3613,6 +3614,13 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
         m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+
+    InvalidateAuraModifierCache(aurEff->GetAuraType());
+}
+
+void Unit::InvalidateAuraModifierCache(AuraType auraType)
+{
+    m_auraModifierCache.erase(auraType);
 }
 
 // All aura base removes should go threw this function!
@@ -4802,14 +4810,63 @@ int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype, std::function<bool(Aur
     return modifier;
 }
 
+namespace
+{
+    // unfiltered totals use their own key outside of the misc value range
+    uint64 MakeAuraModifierCacheKey(bool byMiscValue, int32 miscValue)
+    {
+        return uint64(byMiscValue) << 32 | uint32(miscValue);
+    }
+
+    template<typename T, typename Calculator>
+    T GetCachedAuraModifier(std::unordered_map<uint64, T>* cache, uint64 key, Calculator const& calculate)
+    {
+        if (!cache)
+            return calculate();
+
+        auto itr = cache->find(key);
+        if (itr != cache->end())
+            return itr->second;
+
+        T value = calculate();
+        (*cache)[key] = value;
+        return value;
+    }
+}
+
+Unit::AuraModifierCache* Unit::GetAuraModifierCache(AuraType auratype) const
+{
+    // units of neighbouring regions read each other's totals while the map updates in parallel,
+    // the cache is only used and filled while the map updates serially
+    if (Map* map = FindMap())
+        if (map->IsUpdatingInRegions())
+            return nullptr;
+
+    return &m_auraModifierCache[auratype];
+}
+
 int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
-    return GetTotalAuraModifier(auratype, [](AuraEffect const* /*aurEff*/) { return true; });
+    if (m_modAuras[auratype].empty())
+        return 0;
+
+    AuraModifierCache* cache = GetAuraModifierCache(auratype);
+    return GetCachedAuraModifier(cache ? &cache->Modifiers : nullptr, MakeAuraModifierCacheKey(false, 0), [this, auratype]()
+    {
+        return GetTotalAuraModifier(auratype, [](AuraEffect const* /*aurEff*/) { return true; });
+    });
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
-    return GetTotalAuraMultiplier(auratype, [](AuraEffect const* /*aurEff*/) { return true; });
+    if (m_modAuras[auratype].empty())
+        return 1.0f;
+
+    AuraModifierCache* cache = GetAuraModifierCache(auratype);
+    return GetCachedAuraModifier(cache ? &cache->Multipliers : nullptr, MakeAuraModifierCacheKey(false, 0), [this, auratype]()
+    {
+        return GetTotalAuraMultiplier(auratype, [](AuraEffect const* /*aurEff*/) { return true; });
+    });
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
@@ -4864,21 +4921,35 @@ int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 miscM
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 miscValue) const
 {
-    return GetTotalAuraModifier(auratype, [miscValue](AuraEffect const* aurEff) -> bool
+    if (m_modAuras[auratype].empty())
+        return 0;
+
+    AuraModifierCache* cache = GetAuraModifierCache(auratype);
+    return GetCachedAuraModifier(cache ? &cache->Modifiers : nullptr, MakeAuraModifierCacheKey(true, miscValue), [this, auratype, miscValue]()
     {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
+        return GetTotalAuraModifier(auratype, [miscValue](AuraEffect const* aurEff) -> bool
+        {
+            if (aurEff->GetMiscValue() == miscValue)
+                return true;
+            return false;
+        });
     });
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 miscValue) const
 {
-    return GetTotalAuraMultiplier(auratype, [miscValue](AuraEffect const* aurEff) -> bool
+    if (m_modAuras[auratype].empty())
+        return 1.0f;
+
+    AuraModifierCache* cache = GetAuraModifierCache(auratype);
+    return GetCachedAuraModifier(cache ? &cache->Multipliers : nullptr, MakeAuraModifierCacheKey(true, miscValue), [this, auratype, miscValue]()
     {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
+        return GetTotalAuraMultiplier(auratype, [miscValue](AuraEffect const* aurEff) -> bool
+        {
+            if (aurEff->GetMiscValue() == miscValue)
+                return true;
+            return false;
+        });
     });
 }
 
@@ -14295,6 +14366,140 @@ bool Unit::IsSplineEnabled() const
     return movespline->Initialized() && !movespline->Finalized();
 }
 
+namespace
+{
+    // fields whose value sent to a player depends on that player, see Unit::GetObserverDependentUpdateFieldValue
+    uint16 const ObserverDependentUpdateFields[] =
+    {
+        OBJECT_DYNAMIC_FLAGS,
+        UNIT_FIELD_DISPLAYID,
+        UNIT_FIELD_FLAGS,
+        UNIT_FIELD_AURASTATE,
+        UNIT_NPC_FLAGS,
+        UNIT_FIELD_BYTES_2,
+        UNIT_FIELD_FACTIONTEMPLATE
+    };
+
+    bool IsObserverDependentUpdateField(uint16 index)
+    {
+        return std::find(std::begin(ObserverDependentUpdateFields), std::end(ObserverDependentUpdateFields), index) != std::end(ObserverDependentUpdateFields);
+    }
+}
+
+uint32 Unit::GetObserverDependentUpdateFieldValue(uint16 index, Player* target) const
+{
+    Creature const* creature = ToCreature();
+
+    switch (index)
+    {
+        case UNIT_NPC_FLAGS:
+        {
+            uint32 appendValue = m_uint32Values[UNIT_NPC_FLAGS];
+
+            if (creature)
+                if (!target->CanSeeSpellClickOn(creature))
+                    appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
+
+            return appendValue;
+        }
+        case UNIT_FIELD_AURASTATE:
+            // Check per caster aura states to not enable using a spell in client if specified aura is not by target
+            return BuildAuraStateUpdateForTarget(target);
+        // Gamemasters should be always able to select units - remove not selectable flag
+        case UNIT_FIELD_FLAGS:
+        {
+            uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
+            if (target->IsGameMaster())
+                appendValue &= ~UNIT_FLAG_NOT_SELECTABLE;
+
+            return appendValue;
+        }
+        // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
+        case UNIT_FIELD_DISPLAYID:
+        {
+            uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAYID];
+            if (creature)
+            {
+                CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
+
+                // this also applies for transform auras
+                if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
+                    for (SpellEffectInfo const* effect : transform->GetEffectsForDifficulty(GetMap()->GetDifficultyID()))
+                        if (effect && effect->IsAura(SPELL_AURA_TRANSFORM))
+                            if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(effect->MiscValue))
+                            {
+                                cinfo = transformInfo;
+                                break;
+                            }
+
+                if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
+                    if (target->IsGameMaster())
+                        displayId = cinfo->GetFirstVisibleModel();
+            }
+
+            return displayId;
+        }
+        // hide lootable animation for unallowed players
+        case OBJECT_DYNAMIC_FLAGS:
+        {
+            uint32 dynamicFlags = m_uint32Values[OBJECT_DYNAMIC_FLAGS] & ~UNIT_DYNFLAG_TAPPED;
+
+            if (creature)
+            {
+                if (creature->hasLootRecipient() && !creature->isTappedBy(target))
+                    dynamicFlags |= UNIT_DYNFLAG_TAPPED;
+
+                if (!target->isAllowedToLoot(creature))
+                    dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
+            }
+
+            // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
+            if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
+                if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
+                    dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
+
+            return dynamicFlags;
+        }
+        // FG: pretend that OTHER players in own group are friendly ("blue")
+        case UNIT_FIELD_BYTES_2:
+        case UNIT_FIELD_FACTIONTEMPLATE:
+        {
+            if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
+            {
+                FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
+                FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
+                if (ft1 && ft2 && !ft1->IsFriendlyTo(ft2))
+                {
+                    if (index == UNIT_FIELD_BYTES_2)
+                        // Allow targetting opposite faction in party when enabled in config
+                        return m_uint32Values[UNIT_FIELD_BYTES_2] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8); // this flag is at uint8 offset 1 !!
+                    else
+                        // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
+                        return uint32(target->getFaction());
+                }
+            }
+
+            return m_uint32Values[index];
+        }
+        default:
+            return m_uint32Values[index];
+    }
+}
+
+bool Unit::BuildValuesUpdateCacheKey(Player* target, std::vector<uint32>& key) const
+{
+    if (!WorldObject::BuildValuesUpdateCacheKey(target, key))
+        return false;
+
+    // only the fields written in this values update, the same ones for every observer
+    bool forcedAuraState = HasFlag(UNIT_FIELD_AURASTATE, PER_CASTER_AURA_STATE_MASK);
+    for (uint16 index : ObserverDependentUpdateFields)
+        if (_changesMask[index] || (UnitUpdateFieldFlags[index] & (_fieldNotifyFlags | UF_FLAG_SPECIAL_INFO)) || (index == UNIT_FIELD_AURASTATE && forcedAuraState))
+            key.push_back(GetObserverDependentUpdateFieldValue(index, target));
+
+    return true;
+}
+
 void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) const
 {
     if (!target)
@@ -14322,7 +14527,9 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
     if (plr && plr->IsInSameRaidWith(target))
         visibleFlag |= UF_FLAG_PARTY_MEMBER;
 
-    Creature const* creature = ToCreature();
+    uint32 const* groupFlags = GetUpdateFieldGroupFlags(flags);
+    uint32 forcedFlags = _fieldNotifyFlags | (visibleFlag & UF_FLAG_SPECIAL_INFO);
+    bool forcedAuraState = HasFlag(UNIT_FIELD_AURASTATE, PER_CASTER_AURA_STATE_MASK);
 
     *data << uint8(blockCount);
     std::size_t maskPos = data->wpos();
@@ -14330,28 +14537,24 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
 
     for (uint16 index = 0; index < valCount; ++index)
     {
+        // skip groups of unchanged fields that are not forced by notify flags at once
+        if (updateType == UPDATETYPE_VALUES && !(index % UPDATE_FIELDS_PER_GROUP) && uint32(index + UPDATE_FIELDS_PER_GROUP) <= valCount &&
+            !(groupFlags[index / UPDATE_FIELDS_PER_GROUP] & forcedFlags) && IsUpdateFieldGroupUnchanged(_changesMask.data(), index) &&
+            (!forcedAuraState || UNIT_FIELD_AURASTATE / UPDATE_FIELDS_PER_GROUP != index / UPDATE_FIELDS_PER_GROUP))
+        {
+            index += UPDATE_FIELDS_PER_GROUP - 1;
+            continue;
+        }
+
         if (_fieldNotifyFlags & flags[index] ||
             ((flags[index] & visibleFlag) & UF_FLAG_SPECIAL_INFO) ||
             ((updateType == UPDATETYPE_VALUES ? _changesMask[index] : m_uint32Values[index]) && (flags[index] & visibleFlag)) ||
-            (index == UNIT_FIELD_AURASTATE && HasFlag(UNIT_FIELD_AURASTATE, PER_CASTER_AURA_STATE_MASK)))
+            (index == UNIT_FIELD_AURASTATE && forcedAuraState))
         {
             UpdateMask::SetUpdateBit(data->contents() + maskPos, index);
 
-            if (index == UNIT_NPC_FLAGS)
-            {
-                uint32 appendValue = m_uint32Values[UNIT_NPC_FLAGS];
-
-                if (creature)
-                    if (!target->CanSeeSpellClickOn(creature))
-                        appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
-
-                *data << uint32(appendValue);
-            }
-            else if (index == UNIT_FIELD_AURASTATE)
-            {
-                // Check per caster aura states to not enable using a spell in client if specified aura is not by target
-                *data << BuildAuraStateUpdateForTarget(target);
-            }
+            if (IsObserverDependentUpdateField(index))
+                *data << GetObserverDependentUpdateFieldValue(index, target);
             // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
             // there are some float values which may be negative or can't get negative due to other checks
             else if ((index >= UNIT_FIELD_NEGSTAT && index < UNIT_FIELD_NEGSTAT + MAX_STATS) ||
@@ -14361,83 +14564,6 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
             {
                 *data << uint32(m_floatValues[index]);
             }
-            // Gamemasters should be always able to select units - remove not selectable flag
-            else if (index == UNIT_FIELD_FLAGS)
-            {
-                uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
-                if (target->IsGameMaster())
-                    appendValue &= ~UNIT_FLAG_NOT_SELECTABLE;
-
-                *data << uint32(appendValue);
-            }
-            // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
-            else if (index == UNIT_FIELD_DISPLAYID)
-            {
-                uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAYID];
-                if (creature)
-                {
-                    CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
-
-                    // this also applies for transform auras
-                    if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
-                        for (SpellEffectInfo const* effect : transform->GetEffectsForDifficulty(GetMap()->GetDifficultyID()))
-                            if (effect && effect->IsAura(SPELL_AURA_TRANSFORM))
-                                if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(effect->MiscValue))
-                                {
-                                    cinfo = transformInfo;
-                                    break;
-                                }
-
-                    if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
-                        if (target->IsGameMaster())
-                            displayId = cinfo->GetFirstVisibleModel();
-                }
-
-                *data << uint32(displayId);
-            }
-            // hide lootable animation for unallowed players
-            else if (index == OBJECT_DYNAMIC_FLAGS)
-            {
-                uint32 dynamicFlags = m_uint32Values[OBJECT_DYNAMIC_FLAGS] & ~UNIT_DYNFLAG_TAPPED;
-
-                if (creature)
-                {
-                    if (creature->hasLootRecipient() && !creature->isTappedBy(target))
-                        dynamicFlags |= UNIT_DYNFLAG_TAPPED;
-
-                    if (!target->isAllowedToLoot(creature))
-                        dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
-                }
-
-                // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
-                if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
-                    if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
-                        dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
-
-                *data << dynamicFlags;
-            }
-            // FG: pretend that OTHER players in own group are friendly ("blue")
-            else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
-            {
-                if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
-                {
-                    FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
-                    FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
-                    if (ft1 && ft2 && !ft1->IsFriendlyTo(ft2))
-                    {
-                        if (index == UNIT_FIELD_BYTES_2)
-                            // Allow targetting opposite faction in party when enabled in config
-                            *data << (m_uint32Values[UNIT_FIELD_BYTES_2] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
-                        else
-                            // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
-                            *data << uint32(target->getFaction());
-                    }
-                    else
-                        *data << m_uint32Values[index];
-                }
-                else
-                    *data << m_uint32Values[index];
-            }
             else
             {
                 // send in current format (float as float, uint32 as uint32)
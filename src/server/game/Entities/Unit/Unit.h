@@ -1458,6 +1458,7 @@ class TC_GAME_API Unit : public WorldObject
         void _UnapplyAura(AuraApplication * aurApp, AuraRemoveMode removeMode);
         void _RemoveNoStackAurasDueToAura(Aura* aura);
         void _RegisterAuraEffect(AuraEffect* aurEff, bool apply);
+        void InvalidateAuraModifierCache(AuraType auraType);
 
         // m_ownedAuras container management
         AuraMap      & GetOwnedAuras()       { return m_ownedAuras; }
@@ -1990,6 +1991,8 @@ class TC_GAME_API Unit : public WorldObject
         explicit Unit (bool isWorldObject);
 
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+        bool BuildValuesUpdateCacheKey(Player* target, std::vector<uint32>& key) const override;
+        uint32 GetObserverDependentUpdateFieldValue(uint16 index, Player* target) const;
 
         UnitAI* i_AI, *i_disabledAI;
 
@@ -2029,6 +2032,15 @@ class TC_GAME_API Unit : public WorldObject
         uint32 m_removedAurasCount;
 
         AuraEffectList m_modAuras[TOTAL_AURAS];
+        // totals of GetTotalAuraModifier/GetTotalAuraMultiplier without predicate or by misc value, keyed by MakeAuraModifierCacheKey
+        struct AuraModifierCache
+        {
+            std::unordered_map<uint64, int32> Modifiers;
+            std::unordered_map<uint64, float> Multipliers;
+        };
+        // one bucket per aura type, dropped as a whole when an effect of the type is (un)registered or changes amount
+        mutable std::unordered_map<uint32, AuraModifierCache> m_auraModifierCache;
+        AuraModifierCache* GetAuraModifierCache(AuraType auratype) const;
         AuraList m_scAuras;                        // cast singlecast auras
         AuraApplicationList m_interruptableAuras;  // auras which have interrupt mask applied on unit
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
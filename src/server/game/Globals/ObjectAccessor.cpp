@@ -33,6 +33,27 @@
 
 #include <boost/thread/shared_mutex.hpp>
 #include <boost/thread/locks.hpp>
+#include <shared_mutex>
+
+namespace
+{
+    // Find only locks the shard of the guid, so lookups from different map threads rarely touch the same lock
+    std::size_t const HashMapHolderShardCount = 64;
+
+    template<class T>
+    struct alignas(64) HashMapHolderShard
+    {
+        std::shared_timed_mutex Lock;
+        std::unordered_map<ObjectGuid, T*> Objects;
+    };
+
+    template<class T>
+    HashMapHolderShard<T>& GetHashMapHolderShard(ObjectGuid const& guid)
+    {
+        static HashMapHolderShard<T> shards[HashMapHolderShardCount];
+        return shards[std::hash<ObjectGuid>()(guid) % HashMapHolderShardCount];
+    }
+}
 
 template<class T>
 void HashMapHolder<T>::Insert(T* o)
@@ -44,6 +65,10 @@ void HashMapHolder<T>::Insert(T* o)
     boost::unique_lock<boost::shared_mutex> lock(*GetLock());
 
     GetContainer()[o->GetGUID()] = o;
+
+    HashMapHolderShard<T>& shard = GetHashMapHolderShard<T>(o->GetGUID());
+    std::unique_lock<std::shared_timed_mutex> shardLock(shard.Lock);
+    shard.Objects[o->GetGUID()] = o;
 }
 
 template<class T>
@@ -52,15 +77,20 @@ void HashMapHolder<T>::Remove(T* o)
     boost::unique_lock<boost::shared_mutex> lock(*GetLock());
 
     GetContainer().erase(o->GetGUID());
+
+    HashMapHolderShard<T>& shard = GetHashMapHolderShard<T>(o->GetGUID());
+    std::unique_lock<std::shared_timed_mutex> shardLock(shard.Lock);
+    shard.Objects.erase(o->GetGUID());
 }
 
 template<class T>
 T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    boost::shared_lock<boost::shared_mutex> lock(*GetLock());
+    HashMapHolderShard<T>& shard = GetHashMapHolderShard<T>(guid);
+    std::shared_lock<std::shared_timed_mutex> lock(shard.Lock);
 
-    typename MapType::iterator itr = GetContainer().find(guid);
-    return (itr != GetContainer().end()) ? itr->second : NULL;
+    auto itr = shard.Objects.find(guid);
+    return (itr != shard.Objects.end()) ? itr->second : NULL;
 }
 
 template<class T>
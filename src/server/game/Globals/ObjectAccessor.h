@@ -55,10 +55,12 @@ public:
 
     static void Remove(T* o);
 
+    /// Does not take GetLock(), the objects are also kept in guid sharded maps with a lock each
     static T* Find(ObjectGuid guid);
 
     static MapType& GetContainer();
 
+    /// Guards GetContainer(), needed to iterate it
     static boost::shared_mutex* GetLock();
 };
 
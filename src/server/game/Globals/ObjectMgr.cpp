@@ -51,6 +51,7 @@
 #include "ScriptMgr.h"
 #include "SpellInfo.h"
 #include "SpellMgr.h"
+#include "StartupSnapshot.h"
 #include "SpellScript.h"
 #include "TemporarySummon.h"
 #include "Timer.h"
@@ -2077,10 +2078,19 @@ inline std::vector<Difficulty> ParseSpawnDifficulties(std::string const& difficu
     return difficulties;
 }
 
-void ObjectMgr::LoadCreatures()
+void ObjectMgr::LoadCreatures(StartupSnapshot& snapshot)
 {
     uint32 oldMSTime = getMSTime();
 
+    if (snapshot.IsLoaded())
+    {
+        LoadCreaturesFromSnapshot(snapshot.GetData());
+        TC_LOG_INFO("server.loading", ">> Loaded " SZFMTD " creatures from startup snapshot in %u ms", _creatureDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
+        return;
+    }
+
+    std::vector<ObjectGuid::LowType> gridGuids;
+
     //                                                      0        1   2     3        4          5            6           7           8            9            10           11
     QueryResult result = WorldDatabase.Query("SELECT creature.guid, id, map, areaId, modelid, equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, spawndist, "
     //         12            13        14          15              16              17          18            19                  20                   21                    22
@@ -2093,6 +2103,9 @@ void ObjectMgr::LoadCreatures()
 
     if (!result)
     {
+        if (snapshot.IsEnabled())
+            SaveCreaturesToSnapshot(snapshot.GetData(), gridGuids);
+
         TC_LOG_ERROR("server.loading", ">> Loaded 0 creatures. DB table `creature` is empty.");
         return;
     }
@@ -2324,10 +2337,17 @@ void ObjectMgr::LoadCreatures()
 
         // Add to grid if not managed by the game event or pool system
         if (gameEvent == 0 && PoolId == 0)
+        {
             AddCreatureToGrid(guid, &data);
+            if (snapshot.IsEnabled())
+                gridGuids.push_back(guid);
+        }
     }
     while (result->NextRow());
 
+    if (snapshot.IsEnabled())
+        SaveCreaturesToSnapshot(snapshot.GetData(), gridGuids);
+
     TC_LOG_INFO("server.loading", ">> Loaded " SZFMTD " creatures in %u ms", _creatureDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -2351,6 +2371,101 @@ void ObjectMgr::RemoveCreatureFromGrid(ObjectGuid::LowType guid, CreatureData co
     }
 }
 
+void ObjectMgr::SaveCreaturesToSnapshot(ByteBuffer& data, std::vector<ObjectGuid::LowType> const& gridGuids) const
+{
+    data << uint32(_creatureDataStore.size());
+    for (auto const& creaturePair : _creatureDataStore)
+    {
+        CreatureData const& creature = creaturePair.second;
+        data << uint64(creaturePair.first);
+        data << uint32(creature.id);
+        data << uint16(creature.mapid);
+        data << uint32(creature.areaId);
+        data << uint32(creature.displayid);
+        data << int8(creature.equipmentId);
+        data << float(creature.posX);
+        data << float(creature.posY);
+        data << float(creature.posZ);
+        data << float(creature.orientation);
+        data << uint32(creature.spawntimesecs);
+        data << float(creature.spawndist);
+        data << uint32(creature.currentwaypoint);
+        data << uint32(creature.curhealth);
+        data << uint32(creature.curmana);
+        data << uint8(creature.movementType);
+        data << uint32(creature.spawnDifficulties.size());
+        for (Difficulty difficulty : creature.spawnDifficulties)
+            data << uint8(difficulty);
+        data << uint64(creature.npcflag);
+        data << uint32(creature.unit_flags);
+        data << uint32(creature.unit_flags2);
+        data << uint32(creature.unit_flags3);
+        data << uint32(creature.dynamicflags);
+        data << uint8(creature.phaseUseFlags);
+        data << uint32(creature.phaseId);
+        data << uint32(creature.phaseGroup);
+        data << int32(creature.terrainSwapMap);
+        // script ids are indexes into the sorted script names and change when scripts are added
+        data << GetScriptName(creature.ScriptId);
+        data << float(creature.movementmode);
+        data << uint8(creature.dbData);
+    }
+
+    data << uint32(gridGuids.size());
+    for (ObjectGuid::LowType guid : gridGuids)
+        data << uint64(guid);
+}
+
+void ObjectMgr::LoadCreaturesFromSnapshot(ByteBuffer& data)
+{
+    uint32 count = data.read<uint32>();
+    _creatureDataStore.reserve(count);
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        CreatureData& creature = _creatureDataStore[data.read<uint64>()];
+        creature.id = data.read<uint32>();
+        creature.mapid = data.read<uint16>();
+        creature.areaId = data.read<uint32>();
+        creature.displayid = data.read<uint32>();
+        creature.equipmentId = data.read<int8>();
+        creature.posX = data.read<float>();
+        creature.posY = data.read<float>();
+        creature.posZ = data.read<float>();
+        creature.orientation = data.read<float>();
+        creature.spawntimesecs = data.read<uint32>();
+        creature.spawndist = data.read<float>();
+        creature.currentwaypoint = data.read<uint32>();
+        creature.curhealth = data.read<uint32>();
+        creature.curmana = data.read<uint32>();
+        creature.movementType = data.read<uint8>();
+        creature.spawnDifficulties.resize(data.read<uint32>());
+        for (Difficulty& difficulty : creature.spawnDifficulties)
+            difficulty = Difficulty(data.read<uint8>());
+        creature.npcflag = data.read<uint64>();
+        creature.unit_flags = data.read<uint32>();
+        creature.unit_flags2 = data.read<uint32>();
+        creature.unit_flags3 = data.read<uint32>();
+        creature.dynamicflags = data.read<uint32>();
+        creature.phaseUseFlags = data.read<uint8>();
+        creature.phaseId = data.read<uint32>();
+        creature.phaseGroup = data.read<uint32>();
+        creature.terrainSwapMap = data.read<int32>();
+        std::string scriptName;
+        data >> scriptName;
+        creature.ScriptId = GetScriptId(scriptName);
+        creature.movementmode = data.read<float>();
+        creature.dbData = data.read<uint8>() != 0;
+    }
+
+    uint32 gridCount = data.read<uint32>();
+    for (uint32 i = 0; i < gridCount; ++i)
+    {
+        ObjectGuid::LowType guid = data.read<uint64>();
+        AddCreatureToGrid(guid, &_creatureDataStore[guid]);
+    }
+}
+
 ObjectGuid::LowType ObjectMgr::AddGOData(uint32 entry, uint32 mapId, float x, float y, float z, float o, uint32 spawntimedelay, float rotation0, float rotation1, float rotation2, float rotation3)
 {
     GameObjectTemplate const* goinfo = GetGameObjectTemplate(entry);
@@ -2450,10 +2565,20 @@ ObjectGuid::LowType ObjectMgr::AddCreatureData(uint32 entry, uint32 mapId, float
     return guid;
 }
 
-void ObjectMgr::LoadGameobjects()
+void ObjectMgr::LoadGameobjects(StartupSnapshot& snapshot)
 {
     uint32 oldMSTime = getMSTime();
 
+    if (snapshot.IsLoaded())
+    {
+        LoadGameobjectsFromSnapshot(snapshot.GetData());
+        TC_LOG_INFO("server.loading", ">> Loaded " SZFMTD " gameobjects from startup snapshot in %u ms", _gameObjectDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
+        return;
+    }
+
+    std::vector<ObjectGuid::LowType> gridGuids;
+    std::vector<ObjectGuid::LowType> gatheringNodeGuids;
+
     //                                                0                1   2   3       4           5           6           7
     QueryResult result = WorldDatabase.Query("SELECT gameobject.guid, id, map, areaId, position_x, position_y, position_z, orientation, "
     //   8          9          10          11         12             13            14    15                 16          17
@@ -2465,6 +2590,9 @@ void ObjectMgr::LoadGameobjects()
 
     if (!result)
     {
+        if (snapshot.IsEnabled())
+            SaveGameobjectsToSnapshot(snapshot.GetData(), gridGuids, gatheringNodeGuids);
+
         TC_LOG_ERROR("server.loading", ">> Loaded 0 gameobjects. DB table `gameobject` is empty.");
         return;
     }
@@ -2703,13 +2831,23 @@ void ObjectMgr::LoadGameobjects()
             if (Area* area = sAreaMgr->GetArea(data.areaId))
                 if (Area* zone = area->GetZone())
                     zone->AddGatheringNode(guid, gInfo, Position(data.posX, data.posY, data.posZ));
+
+            if (snapshot.IsEnabled())
+                gatheringNodeGuids.push_back(guid);
         }
         // if not this is to be managed by GameEvent System or Pool system
         else if (gameEvent == 0 && PoolId == 0)
+        {
             AddGameobjectToGrid(guid, &data);
+            if (snapshot.IsEnabled())
+                gridGuids.push_back(guid);
+        }
     }
     while (result->NextRow());
 
+    if (snapshot.IsEnabled())
+        SaveGameobjectsToSnapshot(snapshot.GetData(), gridGuids, gatheringNodeGuids);
+
     TC_LOG_INFO("server.loading", ">> Loaded " SZFMTD " gameobjects in %u ms", _gameObjectDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -2733,6 +2871,104 @@ void ObjectMgr::RemoveGameobjectFromGrid(ObjectGuid::LowType guid, GameObjectDat
     }
 }
 
+void ObjectMgr::SaveGameobjectsToSnapshot(ByteBuffer& data, std::vector<ObjectGuid::LowType> const& gridGuids, std::vector<ObjectGuid::LowType> const& gatheringNodeGuids) const
+{
+    data << uint32(_gameObjectDataStore.size());
+    for (auto const& gameObjectPair : _gameObjectDataStore)
+    {
+        GameObjectData const& gameObject = gameObjectPair.second;
+        data << uint64(gameObjectPair.first);
+        data << uint32(gameObject.id);
+        data << uint16(gameObject.mapid);
+        data << uint32(gameObject.areaId);
+        data << float(gameObject.posX);
+        data << float(gameObject.posY);
+        data << float(gameObject.posZ);
+        data << float(gameObject.orientation);
+        data << float(gameObject.rotation.x);
+        data << float(gameObject.rotation.y);
+        data << float(gameObject.rotation.z);
+        data << float(gameObject.rotation.w);
+        data << int32(gameObject.spawntimesecs);
+        data << uint32(gameObject.animprogress);
+        data << uint8(gameObject.go_state);
+        data << uint32(gameObject.spawnDifficulties.size());
+        for (Difficulty difficulty : gameObject.spawnDifficulties)
+            data << uint8(difficulty);
+        data << uint8(gameObject.artKit);
+        data << uint8(gameObject.phaseUseFlags);
+        data << uint32(gameObject.phaseId);
+        data << uint32(gameObject.phaseGroup);
+        data << int32(gameObject.terrainSwapMap);
+        data << GetScriptName(gameObject.ScriptId);
+        data << uint8(gameObject.dbData);
+        data << uint8(gameObject.isActive);
+    }
+
+    data << uint32(gridGuids.size());
+    for (ObjectGuid::LowType guid : gridGuids)
+        data << uint64(guid);
+
+    data << uint32(gatheringNodeGuids.size());
+    for (ObjectGuid::LowType guid : gatheringNodeGuids)
+        data << uint64(guid);
+}
+
+void ObjectMgr::LoadGameobjectsFromSnapshot(ByteBuffer& data)
+{
+    uint32 count = data.read<uint32>();
+    _gameObjectDataStore.reserve(count);
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        GameObjectData& gameObject = _gameObjectDataStore[data.read<uint64>()];
+        gameObject.id = data.read<uint32>();
+        gameObject.mapid = data.read<uint16>();
+        gameObject.areaId = data.read<uint32>();
+        gameObject.posX = data.read<float>();
+        gameObject.posY = data.read<float>();
+        gameObject.posZ = data.read<float>();
+        gameObject.orientation = data.read<float>();
+        gameObject.rotation.x = data.read<float>();
+        gameObject.rotation.y = data.read<float>();
+        gameObject.rotation.z = data.read<float>();
+        gameObject.rotation.w = data.read<float>();
+        gameObject.spawntimesecs = data.read<int32>();
+        gameObject.animprogress = data.read<uint32>();
+        gameObject.go_state = GOState(data.read<uint8>());
+        gameObject.spawnDifficulties.resize(data.read<uint32>());
+        for (Difficulty& difficulty : gameObject.spawnDifficulties)
+            difficulty = Difficulty(data.read<uint8>());
+        gameObject.artKit = data.read<uint8>();
+        gameObject.phaseUseFlags = data.read<uint8>();
+        gameObject.phaseId = data.read<uint32>();
+        gameObject.phaseGroup = data.read<uint32>();
+        gameObject.terrainSwapMap = data.read<int32>();
+        std::string scriptName;
+        data >> scriptName;
+        gameObject.ScriptId = GetScriptId(scriptName);
+        gameObject.dbData = data.read<uint8>() != 0;
+        gameObject.isActive = data.read<uint8>() != 0;
+    }
+
+    uint32 gridCount = data.read<uint32>();
+    for (uint32 i = 0; i < gridCount; ++i)
+    {
+        ObjectGuid::LowType guid = data.read<uint64>();
+        AddGameobjectToGrid(guid, &_gameObjectDataStore[guid]);
+    }
+
+    uint32 gatheringNodeCount = data.read<uint32>();
+    for (uint32 i = 0; i < gatheringNodeCount; ++i)
+    {
+        ObjectGuid::LowType guid = data.read<uint64>();
+        GameObjectData const& gameObject = _gameObjectDataStore[guid];
+        if (Area* area = sAreaMgr->GetArea(gameObject.areaId))
+            if (Area* zone = area->GetZone())
+                zone->AddGatheringNode(guid, GetGameObjectTemplate(gameObject.id), Position(gameObject.posX, gameObject.posY, gameObject.posZ));
+    }
+}
+
 // name must be checked to correctness (if received) before call this function
 ObjectGuid ObjectMgr::GetPlayerGUIDByName(std::string const& name)
 {
@@ -39,7 +39,9 @@
 #include <memory>
 class CreatureOutfit;
 
+class ByteBuffer;
 class Item;
+class StartupSnapshot;
 class Unit;
 class Vehicle;
 struct AccessRequirement;
@@ -1228,7 +1230,7 @@ class TC_GAME_API ObjectMgr
         void LoadGameObjectQuestItems();
         void LoadCreatureQuestItems();
         void LoadTempSummons();
-        void LoadCreatures();
+        void LoadCreatures(StartupSnapshot& snapshot);
         void LoadLinkedRespawn();
         bool SetCreatureLinkedRespawn(ObjectGuid::LowType guid, ObjectGuid::LowType linkedGuid);
         void LoadCreatureAddons();
@@ -1236,7 +1238,7 @@ class TC_GAME_API ObjectMgr
         void LoadCreatureModelInfo();
         void LoadEquipmentTemplates();
         void LoadGameObjectLocales();
-        void LoadGameobjects();
+        void LoadGameobjects(StartupSnapshot& snapshot);
         void LoadItemTemplates();
         void LoadItemTemplateAddon();
         void LoadItemScriptNames();
@@ -1672,6 +1674,12 @@ class TC_GAME_API ObjectMgr
         uint32 GetScriptIdForGarrison(uint32 siteLevelId);
 
     private:
+        // spawns after validation, with the guids that were added to the grids
+        void LoadCreaturesFromSnapshot(ByteBuffer& data);
+        void SaveCreaturesToSnapshot(ByteBuffer& data, std::vector<ObjectGuid::LowType> const& gridGuids) const;
+        void LoadGameobjectsFromSnapshot(ByteBuffer& data);
+        void SaveGameobjectsToSnapshot(ByteBuffer& data, std::vector<ObjectGuid::LowType> const& gridGuids, std::vector<ObjectGuid::LowType> const& gatheringNodeGuids) const;
+
         // first free id for selected id type
         uint32 _auctionId;
         uint64 _equipmentSetGuid;
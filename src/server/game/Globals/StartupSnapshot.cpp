@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StartupSnapshot.h"
+#include "DatabaseEnv.h"
+#include "DB2Stores.h"
+#include "GitRevision.h"
+#include "Log.h"
+#include "Realm.h"
+#include "SHA1.h"
+#include "Timer.h"
+#include "VMapFactory.h"
+#include "World.h"
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    uint32 const SnapshotMagic = 0x53534354; // "TCSS"
+    // bump whenever the layout written by any loader changes
+    uint32 const SnapshotVersion = 1;
+
+    struct SnapshotHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        uint8 Key[SHA_DIGEST_LENGTH];
+        uint8 DataDigest[SHA_DIGEST_LENGTH];
+        uint64 DataSize;
+    };
+
+    void CalculateDataDigest(ByteBuffer const& data, uint8* digest)
+    {
+        SHA1Hash sha;
+        if (!data.empty())
+            sha.UpdateData(data.contents(), int(data.size()));
+        sha.Finalize();
+        memcpy(digest, sha.GetDigest(), SHA_DIGEST_LENGTH);
+    }
+}
+
+StartupSnapshot::StartupSnapshot(std::string const& fileName, std::vector<std::string> const& sourceTables)
+    : _fileName(fileName), _sourceTables(sourceTables), _key(), _loaded(false)
+{
+}
+
+void StartupSnapshot::CalculateKey()
+{
+    SHA1Hash sha;
+    sha.UpdateData(GitRevision::GetHash());
+    sha.UpdateData(reinterpret_cast<uint8 const*>(&realm.Build), sizeof(realm.Build));
+
+    for (std::pair<uint64 const, int32> const& hotfix : sDB2Manager.GetHotfixData())
+    {
+        sha.UpdateData(reinterpret_cast<uint8 const*>(&hotfix.first), sizeof(hotfix.first));
+        sha.UpdateData(reinterpret_cast<uint8 const*>(&hotfix.second), sizeof(hotfix.second));
+    }
+
+    // spawn loaders validate positions and fill missing zone/area ids from the map data when these allow it
+    VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
+    uint8 const loadSettings[] =
+    {
+        uint8(sWorld->getBoolConfig(CONFIG_CREATURE_CHECK_INVALID_POSITION)),
+        uint8(sWorld->getBoolConfig(CONFIG_GAME_OBJECT_CHECK_INVALID_POSITION)),
+        uint8(vmgr->isLineOfSightCalcEnabled()),
+        uint8(vmgr->isHeightCalcEnabled())
+    };
+    sha.UpdateData(loadSettings, sizeof(loadSettings));
+    sha.UpdateData(sWorld->GetDataPath());
+
+    std::string tables;
+    for (std::string const& table : _sourceTables)
+        tables += (tables.empty() ? "`" : ", `") + table + '`';
+
+    if (QueryResult result = WorldDatabase.PQuery("CHECKSUM TABLE %s", tables.c_str()))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            sha.UpdateData(fields[0].GetString());
+            // null for tables that do not exist
+            uint64 checksum = fields[1].IsNull() ? 0 : fields[1].GetUInt64();
+            sha.UpdateData(reinterpret_cast<uint8 const*>(&checksum), sizeof(checksum));
+        } while (result->NextRow());
+    }
+
+    sha.Finalize();
+    memcpy(_key.data(), sha.GetDigest(), _key.size());
+}
+
+bool StartupSnapshot::Load()
+{
+    if (!IsEnabled())
+        return false;
+
+    uint32 oldMSTime = getMSTime();
+
+    CalculateKey();
+
+    FILE* file = fopen(_fileName.c_str(), "rb");
+    if (!file)
+    {
+        TC_LOG_INFO("server.loading", "Startup snapshot %s does not exist yet, it will be created.", _fileName.c_str());
+        return false;
+    }
+
+    SnapshotHeader header;
+    bool valid = fread(&header, sizeof(header), 1, file) == 1
+        && header.Magic == SnapshotMagic
+        && header.Version == SnapshotVersion
+        && !memcmp(header.Key, _key.data(), _key.size());
+
+    if (valid && header.DataSize)
+    {
+        _data.resize(header.DataSize);
+        valid = fread(_data.contents(), 1, header.DataSize, file) == header.DataSize;
+    }
+
+    fclose(file);
+
+    if (valid)
+    {
+        uint8 digest[SHA_DIGEST_LENGTH];
+        CalculateDataDigest(_data, digest);
+        valid = !memcmp(header.DataDigest, digest, SHA_DIGEST_LENGTH);
+    }
+
+    if (!valid)
+    {
+        TC_LOG_INFO("server.loading", "Startup snapshot %s was made from different data or is damaged, it will be rebuilt.", _fileName.c_str());
+        _data.clear();
+        return false;
+    }
+
+    _data.rpos(0);
+    _loaded = true;
+    TC_LOG_INFO("server.loading", ">> Loaded startup snapshot %s (" SZFMTD " bytes) in %u ms", _fileName.c_str(), _data.size(), GetMSTimeDiffToNow(oldMSTime));
+    return true;
+}
+
+void StartupSnapshot::Save()
+{
+    if (!IsEnabled() || _loaded)
+        return;
+
+    SnapshotHeader header;
+    header.Magic = SnapshotMagic;
+    header.Version = SnapshotVersion;
+    memcpy(header.Key, _key.data(), _key.size());
+    CalculateDataDigest(_data, header.DataDigest);
+    header.DataSize = _data.size();
+
+    // write next to the old file first so a crash never leaves a partial snapshot behind
+    std::string tempFileName = _fileName + ".tmp";
+    FILE* file = fopen(tempFileName.c_str(), "wb");
+    if (!file)
+    {
+        TC_LOG_ERROR("server.loading", "Could not create startup snapshot %s.", tempFileName.c_str());
+        return;
+    }
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+        && (_data.empty() || fwrite(_data.contents(), 1, _data.size(), file) == _data.size());
+
+    if (fclose(file) != 0 || !written)
+    {
+        TC_LOG_ERROR("server.loading", "Could not write startup snapshot %s.", tempFileName.c_str());
+        remove(tempFileName.c_str());
+        return;
+    }
+
+    remove(_fileName.c_str());
+    if (rename(tempFileName.c_str(), _fileName.c_str()) != 0)
+    {
+        TC_LOG_ERROR("server.loading", "Could not rename %s to %s.", tempFileName.c_str(), _fileName.c_str());
+        return;
+    }
+
+    TC_LOG_INFO("server.loading", ">> Saved startup snapshot %s (" SZFMTD " bytes)", _fileName.c_str(), _data.size());
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef StartupSnapshot_h__
+#define StartupSnapshot_h__
+
+#include "ByteBuffer.h"
+#include "Define.h"
+#include <openssl/sha.h>
+#include <array>
+#include <string>
+#include <vector>
+
+/// Startup data saved after validation and post-processing, reused on the next start as long as
+/// the core revision, the DB2 build and hotfixes and the checksums of its source tables are unchanged.
+/// When loaded GetData() is read back in the order it was written, otherwise the loaders write into it.
+class TC_GAME_API StartupSnapshot
+{
+public:
+    /// An empty file name disables the snapshot
+    StartupSnapshot(std::string const& fileName, std::vector<std::string> const& sourceTables);
+
+    /// false when disabled, missing, damaged or made from different data
+    bool Load();
+    /// Replaces the file with what the loaders wrote, does nothing when the snapshot was loaded
+    void Save();
+
+    bool IsEnabled() const { return !_fileName.empty(); }
+    bool IsLoaded() const { return _loaded; }
+    ByteBuffer& GetData() { return _data; }
+
+private:
+    typedef std::array<uint8, SHA_DIGEST_LENGTH> Digest;
+
+    void CalculateKey();
+
+    std::string _fileName;
+    std::vector<std::string> _sourceTables;
+    Digest _key;
+    ByteBuffer _data;
+    bool _loaded;
+};
+
+#endif // StartupSnapshot_h__
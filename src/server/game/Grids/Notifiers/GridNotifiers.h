@@ -20,6 +20,7 @@
 #define TRINITY_GRIDNOTIFIERS_H
 
 #include "AreaTrigger.h"
+#include "BroadcastPacket.h"
 #include "Creature.h"
 #include "Corpse.h"
 #include "Conversation.h"
@@ -124,6 +125,7 @@ namespace Trinity
     {
         WorldObject const* i_source;
         WorldPacket const* i_message;
+        BroadcastPacketPtr i_broadcast;
         float i_distSq;
         uint32 team;
         Player const* skipped_receiver;
@@ -151,7 +153,10 @@ namespace Trinity
             if (!player->HaveAtClient(i_source))
                 return;
 
-            player->SendDirectMessage(i_message);
+            if (!i_broadcast)
+                i_broadcast = std::make_shared<BroadcastPacket>(*i_message);
+
+            player->GetSession()->SendPacket(i_broadcast);
         }
     };
 
@@ -1376,8 +1381,8 @@ namespace Trinity
     class AnyAssistCreatureInRangeCheck
     {
         public:
-            AnyAssistCreatureInRangeCheck(Unit* funit, Unit* enemy, float range)
-                : i_funit(funit), i_enemy(enemy), i_range(range) { }
+            AnyAssistCreatureInRangeCheck(Unit* funit, Unit* enemy, float range, bool useLOS = true)
+                : i_funit(funit), i_enemy(enemy), i_range(range), i_useLOS(useLOS) { }
 
             bool operator()(Creature* u) const
             {
@@ -1392,7 +1397,7 @@ namespace Trinity
                     return false;
 
                 // only if see assisted creature
-                if (!i_funit->IsWithinLOSInMap(u))
+                if (i_useLOS && !i_funit->IsWithinLOSInMap(u))
                     return false;
 
                 return true;
@@ -1402,6 +1407,7 @@ namespace Trinity
             Unit* const i_funit;
             Unit* const i_enemy;
             float i_range;
+            bool i_useLOS;
     };
 
     class NearestAssistCreatureInCreatureRangeCheck
@@ -21,7 +21,6 @@
 #include "HotfixPackets.h"
 #include "Log.h"
 #include "ObjectDefines.h"
-#include "World.h"
 
 void WorldSession::HandleDBQueryBulk(WorldPackets::Hotfix::DBQueryBulk& dbQuery)
 {
@@ -32,6 +31,9 @@ void WorldSession::HandleDBQueryBulk(WorldPackets::Hotfix::DBQueryBulk& dbQuery)
         return;
     }
 
+    // handled on a network thread, the world game time is only safe to read from the world thread
+    time_t const now = time(NULL);
+
     for (WorldPackets::Hotfix::DBQueryBulk::DBQueryRecord const& record : dbQuery.Queries)
     {
         WorldPackets::Hotfix::DBReply dbReply;
@@ -41,13 +43,13 @@ void WorldSession::HandleDBQueryBulk(WorldPackets::Hotfix::DBQueryBulk& dbQuery)
         if (store->HasRecord(record.RecordID))
         {
             dbReply.Allow = true;
-            dbReply.Timestamp = sWorld->GetGameTime();
+            dbReply.Timestamp = now;
             store->WriteRecord(record.RecordID, GetSessionDbcLocale(), dbReply.Data);
         }
         else
         {
             TC_LOG_TRACE("network", "CMSG_DB_QUERY_BULK: %s requested non-existing entry %u in datastore: %u", GetPlayerInfo().c_str(), record.RecordID, dbQuery.TableHash);
-            dbReply.Timestamp = time(NULL);
+            dbReply.Timestamp = now;
         }
 
         SendPacket(dbReply.Write());
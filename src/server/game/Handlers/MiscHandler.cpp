@@ -51,6 +51,7 @@
 #include "ScriptMgr.h"
 #include "Spell.h"
 #include "SpellPackets.h"
+#include "WhoListStorage.h"
 #include "WhoPackets.h"
 #include "World.h"
 #include "WorldPacket.h"
@@ -160,75 +161,47 @@ void WorldSession::HandleWhoOpcode(WorldPackets::Who::WhoRequestPkt& whoRequest)
     uint32 team = _player->GetTeam();
 
     uint32 gmLevelInWhoList  = sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_WHO_LIST);
+    uint32 maxWho = sWorld->getIntConfig(CONFIG_MAX_WHO);
+    bool twoSideWhoList = HasPermission(rbac::RBAC_PERM_TWO_SIDE_WHO_LIST);
+    bool seeAllSecLevels = HasPermission(rbac::RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS);
 
     WorldPackets::Who::WhoResponsePkt response;
 
-    boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
+    // the snapshot is rebuilt by the world every few seconds, only the players that pass its filters are looked up
+    std::shared_ptr<WhoListSnapshot const> snapshot = sWhoListStorageMgr->GetSnapshot();
 
-    HashMapHolder<Player>::MapType const& m = ObjectAccessor::GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+    auto addIfMatching = [&](WhoListPlayerInfo const& target)
     {
-        Player* target = itr->second;
         // player can see member of other team only if has RBAC_PERM_TWO_SIDE_WHO_LIST
-        if (target->GetTeam() != team && !HasPermission(rbac::RBAC_PERM_TWO_SIDE_WHO_LIST))
-            continue;
+        if (target.Team != team && !twoSideWhoList)
+            return;
 
         // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if has RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS
-        if (target->GetSession()->GetSecurity() > AccountTypes(gmLevelInWhoList) && !HasPermission(rbac::RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS))
-            continue;
-
-        // do not process players which are not in world
-        if (!target->IsInWorld())
-            continue;
-
-        // check if target is globally visible for player
-        if (!target->IsVisibleGloballyFor(_player))
-            continue;
+        if (target.Security > AccountTypes(gmLevelInWhoList) && !seeAllSecLevels)
+            return;
 
         // check if target's level is in level range
-        uint8 lvl = target->getLevel();
-        if (lvl < request.MinLevel || lvl > request.MaxLevel)
-            continue;
+        if (target.Level < request.MinLevel || target.Level > request.MaxLevel)
+            return;
 
         // check if class matches classmask
-        if (request.ClassFilter >= 0 && !(request.ClassFilter & (1 << target->getClass())))
-            continue;
+        if (request.ClassFilter >= 0 && !(request.ClassFilter & (1 << target.Class)))
+            return;
 
         // check if race matches racemask
-        if (request.RaceFilter >= 0 && !(request.RaceFilter & (SI64LIT(1) << target->getRace())))
-            continue;
-
-        if (!whoRequest.Areas.empty())
-        {
-            if (std::find(whoRequest.Areas.begin(), whoRequest.Areas.end(), target->GetZoneId()) == whoRequest.Areas.end())
-                continue;
-        }
-
-        std::wstring wTargetName;
-
-        if (!Utf8toWStr(target->GetName(), wTargetName))
-            continue;
-
-        wstrToLower(wTargetName);
-
-        if (!wPlayerName.empty() && wTargetName.find(wPlayerName) == std::wstring::npos)
-            continue;
-
-        Guild* targetGuild = target->GetGuild();
-        std::wstring wTargetGuildName;
-
-        if (!Utf8toWStr(targetGuild ? targetGuild->GetName() : "", wTargetGuildName))
-            continue;
+        if (request.RaceFilter >= 0 && !(request.RaceFilter & (SI64LIT(1) << target.Race)))
+            return;
 
-        wstrToLower(wTargetGuildName);
+        if (!wPlayerName.empty() && target.LowerName.find(wPlayerName) == std::wstring::npos)
+            return;
 
-        if (!wGuildName.empty() && wTargetGuildName.find(wGuildName) == std::wstring::npos)
-            continue;
+        if (!wGuildName.empty() && target.LowerGuildName.find(wGuildName) == std::wstring::npos)
+            return;
 
         if (!wWords.empty())
         {
             std::string aName;
-            if (AreaTableEntry const* areaEntry = sAreaTableStore.LookupEntry(target->GetZoneId()))
+            if (AreaTableEntry const* areaEntry = sAreaTableStore.LookupEntry(target.ZoneId))
                 aName = areaEntry->AreaName->Str[GetSessionDbcLocale()];
 
             bool show = false;
@@ -236,8 +209,8 @@ void WorldSession::HandleWhoOpcode(WorldPackets::Who::WhoRequestPkt& whoRequest)
             {
                 if (!wWords[i].empty())
                 {
-                    if (wTargetName.find(wWords[i]) != std::wstring::npos ||
-                        wTargetGuildName.find(wWords[i]) != std::wstring::npos ||
+                    if (target.LowerName.find(wWords[i]) != std::wstring::npos ||
+                        target.LowerGuildName.find(wWords[i]) != std::wstring::npos ||
                         Utf8FitTo(aName, wWords[i]))
                     {
                         show = true;
@@ -247,30 +220,105 @@ void WorldSession::HandleWhoOpcode(WorldPackets::Who::WhoRequestPkt& whoRequest)
             }
 
             if (!show)
-                continue;
+                return;
         }
 
+        // visibility changes (GM invisibility, logout) must not wait for the next snapshot
+        Player* player = ObjectAccessor::FindConnectedPlayer(target.Guid);
+        if (!player || !player->IsInWorld())
+            return;
+
+        // check if target is globally visible for player
+        if (!player->IsVisibleGloballyFor(_player))
+            return;
+
         WorldPackets::Who::WhoEntry whoEntry;
-        if (!whoEntry.PlayerData.Initialize(target->GetGUID(), target))
-            continue;
+        whoEntry.PlayerData = target.PlayerData;
 
-        if (targetGuild)
+        if (!target.GuildGuid.IsEmpty())
         {
-            whoEntry.GuildGUID = targetGuild->GetGUID();
+            whoEntry.GuildGUID = target.GuildGuid;
             whoEntry.GuildVirtualRealmAddress = GetVirtualRealmAddress();
-            whoEntry.GuildName = targetGuild->GetName();
+            whoEntry.GuildName = target.GuildName;
         }
 
-        whoEntry.AreaID = target->GetZoneId();
-        whoEntry.IsGM = target->IsGameMaster();
+        whoEntry.AreaID = target.ZoneId;
+        whoEntry.IsGM = player->IsGameMaster();
 
         response.Response.Entries.push_back(whoEntry);
+    };
 
-        // 50 is maximum player count sent to client - can be overridden
-        // through config, but is unstable
-        if (response.Response.Entries.size() >= sWorld->getIntConfig(CONFIG_MAX_WHO))
-            break;
+    // 50 is maximum player count sent to client - can be overridden
+    // through config, but is unstable
+    WhoListSnapshot::PlayerContainer const& players = snapshot->GetPlayers();
+
+    // candidates come from the most selective index (zone, then the smaller of level range and class mask),
+    // they are visited in snapshot order so the result does not depend on the index used
+    std::vector<uint32> candidates;
+    bool indexed = false;
+    if (!whoRequest.Areas.empty())
+    {
+        for (size_t i = 0; i < whoRequest.Areas.size(); ++i)
+        {
+            // the same zone may be requested more than once
+            if (std::find(whoRequest.Areas.begin(), whoRequest.Areas.begin() + i, whoRequest.Areas[i]) != whoRequest.Areas.begin() + i)
+                continue;
+
+            if (WhoListSnapshot::IndexContainer const* playersInZone = snapshot->GetPlayersInZone(whoRequest.Areas[i]))
+                candidates.insert(candidates.end(), playersInZone->begin(), playersInZone->end());
+        }
+
+        indexed = true;
     }
+    else
+    {
+        uint32 minLevel = request.MinLevel;
+        uint32 maxLevel = std::min<uint32>(request.MaxLevel, STRONG_MAX_LEVEL);
+
+        size_t levelCount = 0;
+        for (uint32 level = minLevel; level <= maxLevel; ++level)
+            levelCount += snapshot->GetPlayersOfLevel(level).size();
+
+        size_t classCount = players.size();
+        if (request.ClassFilter >= 0)
+        {
+            classCount = 0;
+            for (uint8 playerClass = 0; playerClass < MAX_CLASSES; ++playerClass)
+                if (request.ClassFilter & (1 << playerClass))
+                    classCount += snapshot->GetPlayersOfClass(playerClass).size();
+        }
+
+        if (levelCount < players.size() && levelCount <= classCount)
+        {
+            candidates.reserve(levelCount);
+            for (uint32 level = minLevel; level <= maxLevel; ++level)
+                candidates.insert(candidates.end(), snapshot->GetPlayersOfLevel(level).begin(), snapshot->GetPlayersOfLevel(level).end());
+
+            indexed = true;
+        }
+        else if (classCount < players.size())
+        {
+            candidates.reserve(classCount);
+            for (uint8 playerClass = 0; playerClass < MAX_CLASSES; ++playerClass)
+                if (request.ClassFilter & (1 << playerClass))
+                    candidates.insert(candidates.end(), snapshot->GetPlayersOfClass(playerClass).begin(), snapshot->GetPlayersOfClass(playerClass).end());
+
+            indexed = true;
+        }
+    }
+
+    if (indexed)
+    {
+        std::sort(candidates.begin(), candidates.end());
+        for (std::vector<uint32>::const_iterator itr = candidates.begin(); itr != candidates.end() && response.Response.Entries.size() < maxWho; ++itr)
+            addIfMatching(players[*itr]);
+    }
+    else
+    {
+        for (WhoListSnapshot::PlayerContainer::const_iterator itr = players.begin(); itr != players.end() && response.Response.Entries.size() < maxWho; ++itr)
+            addIfMatching(*itr);
+    }
+
     bool Skip = false;
     sScriptMgr->OnHandleWhoOpcode(this, whoRequest, _player, Skip);
     if (!Skip)
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridMapPreloader.h"
+#include "Log.h"
+#include "Map.h"
+#include "StringFormat.h"
+#include "World.h"
+
+namespace
+{
+    // grids that are not entered after this time were mispredicted
+    time_t const PreloadedGridMapExpireTime = 2 * MINUTE;
+
+    // do not keep loading if players fly faster than the disk can keep up with
+    std::size_t const MaxQueuedRequests = 64;
+}
+
+GridMapPreloader::~GridMapPreloader()
+{
+    Stop();
+}
+
+void GridMapPreloader::Start()
+{
+    if (IsRunning())
+        return;
+
+    _stop = false;
+    _thread = std::thread(&GridMapPreloader::WorkerThread, this);
+}
+
+void GridMapPreloader::Stop()
+{
+    if (!IsRunning())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _stop = true;
+        _requests.clear();
+        _queued.clear();
+    }
+
+    _condition.notify_all();
+    _thread.join();
+
+    for (auto& pair : _loaded)
+        delete pair.second.Data;
+
+    _loaded.clear();
+}
+
+void GridMapPreloader::Request(uint32 mapId, int32 gx, int32 gy)
+{
+    uint32 key = MakeKey(mapId, gx, gy);
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (_stop || _requests.size() >= MaxQueuedRequests)
+            return;
+
+        if (_loaded.count(key) || !_queued.insert(key).second)
+            return;
+
+        _requests.push_back(key);
+    }
+
+    _condition.notify_one();
+}
+
+GridMap* GridMapPreloader::Take(uint32 mapId, int32 gx, int32 gy)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    auto itr = _loaded.find(MakeKey(mapId, gx, gy));
+    if (itr == _loaded.end())
+        return nullptr;
+
+    GridMap* gridMap = itr->second.Data;
+    _loaded.erase(itr);
+    return gridMap;
+}
+
+std::string GridMapPreloader::GetFileName(uint32 mapId, int32 gx, int32 gy)
+{
+    return Trinity::StringFormat("%smaps/%04u_%02u_%02u.map", sWorld->GetDataPath().c_str(), mapId, gx, gy);
+}
+
+void GridMapPreloader::WorkerThread()
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    while (!_stop)
+    {
+        if (_requests.empty())
+        {
+            _condition.wait(lock);
+            continue;
+        }
+
+        uint32 key = _requests.front();
+        _requests.pop_front();
+
+        lock.unlock();
+
+        std::string fileName = GetFileName(key >> 12, (key >> 6) & 0x3F, key & 0x3F);
+        GridMap* gridMap = new GridMap();
+        if (!gridMap->loadData(fileName.c_str()))
+        {
+            // leave the error reporting to the synchronous load
+            TC_LOG_DEBUG("maps", "GridMapPreloader: could not preload map file %s", fileName.c_str());
+            delete gridMap;
+            gridMap = nullptr;
+        }
+        else
+            gridMap->prefetchData();
+
+        lock.lock();
+
+        _queued.erase(key);
+
+        time_t now = time(nullptr);
+        RemoveExpired(now);
+
+        if (_stop)
+        {
+            delete gridMap;
+            break;
+        }
+
+        _loaded[key] = { gridMap, now };
+    }
+}
+
+void GridMapPreloader::RemoveExpired(time_t now)
+{
+    for (auto itr = _loaded.begin(); itr != _loaded.end();)
+    {
+        if (itr->second.LoadTime + PreloadedGridMapExpireTime < now)
+        {
+            delete itr->second.Data;
+            itr = _loaded.erase(itr);
+        }
+        else
+            ++itr;
+    }
+}
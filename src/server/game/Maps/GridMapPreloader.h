@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GridMapPreloader_h__
+#define GridMapPreloader_h__
+
+#include "Define.h"
+#include <condition_variable>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+class GridMap;
+
+// Loads the terrain files of grids that players are about to enter on a background thread, reading mapped files into the page cache.
+// Map::LoadMapImpl takes the decoded GridMap when the grid is created instead of reading the file inside the map update.
+class TC_GAME_API GridMapPreloader
+{
+    public:
+        GridMapPreloader() : _stop(false) { }
+        ~GridMapPreloader();
+
+        void Start();
+        void Stop();
+        bool IsRunning() const { return _thread.joinable(); }
+
+        // Called from map threads, requests for grids already queued or loaded are ignored
+        void Request(uint32 mapId, int32 gx, int32 gy);
+
+        // Returns the preloaded terrain of the grid and hands its ownership to the caller, nullptr if it is not ready
+        GridMap* Take(uint32 mapId, int32 gx, int32 gy);
+
+        static std::string GetFileName(uint32 mapId, int32 gx, int32 gy);
+
+    private:
+        struct PreloadedGridMap
+        {
+            GridMap* Data;                                  // nullptr if the file could not be loaded
+            time_t LoadTime;
+        };
+
+        static uint32 MakeKey(uint32 mapId, int32 gx, int32 gy) { return mapId << 12 | uint32(gx) << 6 | uint32(gy); }
+
+        void WorkerThread();
+        void RemoveExpired(time_t now);
+
+        std::mutex _lock;
+        std::condition_variable _condition;
+        std::deque<uint32> _requests;
+        std::unordered_set<uint32> _queued;
+        std::unordered_map<uint32, PreloadedGridMap> _loaded;
+        std::thread _thread;
+        bool _stop;
+};
+
+#endif // GridMapPreloader_h__
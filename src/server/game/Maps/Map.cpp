@@ -18,6 +18,7 @@
 
 #include "Map.h"
 #include "Battleground.h"
+#include "BroadcastPacket.h"
 #include "CellImpl.h"
 #include "Conversation.h"
 #include "DatabaseEnv.h"
@@ -34,12 +35,16 @@
 #include "Log.h"
 #include "MapInstanced.h"
 #include "MapManager.h"
+#include "Metric.h"
 #include "MiscPackets.h"
 #include "MMapFactory.h"
 #include "MotionMaster.h"
+#include "MoveSpline.h"
 #include "ObjectAccessor.h"
 #include "ObjectGridLoader.h"
 #include "ObjectMgr.h"
+#include "PathCorridorCache.h"
+#include "PathGenerator.h"
 #include "Pet.h"
 #include "SceneObject.h"
 #include "PhasingHandler.h"
@@ -51,9 +56,13 @@
 #include "WeatherMgr.h"
 #include "World.h"
 #include "WorldSession.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <algorithm>
 
 u_map_magic MapMagic        = { {'M','A','P','S'} };
-u_map_magic MapVersionMagic = { {'v','1','.','9'} };
+u_map_magic MapVersionMagic = { {'v','2','.','0'} };
+u_map_magic MapLegacyVersionMagic = { {'v','1','.','9'} };   // same layout without section alignment, still accepted
 u_map_magic MapAreaMagic    = { {'A','R','E','A'} };
 u_map_magic MapHeightMagic  = { {'M','H','G','T'} };
 u_map_magic MapLiquidMagic  = { {'M','L','I','Q'} };
@@ -108,7 +117,7 @@ bool Map::ExistMap(uint32 mapid, int gx, int gy)
         map_fileheader header;
         if (fread(&header, sizeof(header), 1, file) == 1)
         {
-            if (header.mapMagic.asUInt != MapMagic.asUInt || header.versionMagic.asUInt != MapVersionMagic.asUInt)
+            if (header.mapMagic.asUInt != MapMagic.asUInt || (header.versionMagic.asUInt != MapVersionMagic.asUInt && header.versionMagic.asUInt != MapLegacyVersionMagic.asUInt))
                 TC_LOG_ERROR("maps", "Map file '%s' is from an incompatible map version (%.*s %.*s), %.*s %.*s is expected. Please pull your source, recompile tools and recreate maps using the updated mapextractor, then replace your old map files with new files. If you still have problems search on forum for error TCE00018.",
                     fileName.c_str(), 4, header.mapMagic.asChar, 4, header.versionMagic.asChar, 4, MapMagic.asChar, 4, MapVersionMagic.asChar);
             else
@@ -199,13 +208,27 @@ void Map::LoadMapImpl(Map* map, int gx, int gy)
         return;
     }
 
-    // map file name
-    std::string fileName = Trinity::StringFormat("%smaps/%04u_%02u_%02u.map", sWorld->GetDataPath().c_str(), map->GetId(), gx, gy);
-    TC_LOG_DEBUG("maps", "Loading map %s", fileName.c_str());
-    // loading data
-    map->GridMaps[gx][gy] = new GridMap();
-    if (!map->GridMaps[gx][gy]->loadData(fileName.c_str()))
-        TC_LOG_ERROR("maps", "Error loading map file: %s", fileName.c_str());
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    // the terrain may already have been read by the preloader
+    GridMap* gridMap = sMapMgr->GetGridMapPreloader()->Take(map->GetId(), gx, gy);
+    bool preloaded = gridMap != nullptr;
+    if (!gridMap)
+    {
+        // map file name
+        std::string fileName = GridMapPreloader::GetFileName(map->GetId(), gx, gy);
+        TC_LOG_DEBUG("maps", "Loading map %s", fileName.c_str());
+        // loading data
+        gridMap = new GridMap();
+        if (!gridMap->loadData(fileName.c_str()))
+            TC_LOG_ERROR("maps", "Error loading map file: %s", fileName.c_str());
+    }
+
+    map->GridMaps[gx][gy] = gridMap;
+
+    TC_METRIC_VALUE("grid_terrain_load_time", uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count()),
+        TC_METRIC_TAG("map_id", std::to_string(map->GetId())),
+        TC_METRIC_TAG("preloaded", preloaded ? "1" : "0"));
 
     sScriptMgr->OnLoadGridMap(map, map->GridMaps[gx][gy], gx, gy);
 }
@@ -266,12 +289,15 @@ void Map::DeleteStateMachine()
 
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, Difficulty SpawnMode, Map* _parent):
 _creatureToMoveLock(false), _gameObjectsToMoveLock(false), _dynamicObjectsToMoveLock(false), _areaTriggersToMoveLock(false),
+_regionUpdateInProgress(false), _collectPathRequests(false), _pathCorridorCache(Trinity::make_unique<PathCorridorCache>()),
+_lastUpdateTime(0), _postponedUpdateDiff(0),
 i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
 m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
 i_gridExpiry(expiry),
-i_scriptLock(false), _defaultLight(DB2Manager::GetDefaultMapLight(id))
+i_scriptLock(false), _defaultLight(DB2Manager::GetDefaultMapLight(id)),
+_valuesUpdateBlocksBuilt(0), _valuesUpdateBlocksShared(0)
 {
     if (_parent)
     {
@@ -632,6 +658,8 @@ void Map::InitializeObject(GameObject* obj)
 template<class T>
 bool Map::AddToMap(T* obj)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+
     /// @todo Needs clean up. An object should not be added to map twice.
     if (obj->IsInWorld())
     {
@@ -677,6 +705,8 @@ bool Map::AddToMap(T* obj)
 template<>
 bool Map::AddToMap(Transport* obj)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+
     //TODO: Needs clean up. An object should not be added to map twice.
     if (obj->IsInWorld())
         return true;
@@ -745,6 +775,274 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
     }
 }
 
+void Map::CollectNearbyCellsOf(WorldObject* obj, std::vector<CellCoord>& cells)
+{
+    // Check for valid position
+    if (!obj->IsPositionValid())
+        return;
+
+    // Same cells as VisitNearbyCellsOf, they are only visited later by UpdateCellsInRegions
+    CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), obj->GetGridActivationRange());
+
+    for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+    {
+        for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+        {
+            uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+            if (isCellMarked(cell_id))
+                continue;
+
+            markCell(cell_id);
+            cells.emplace_back(x, y);
+        }
+    }
+}
+
+bool Map::CanUpdateInRegions() const
+{
+    if (!sWorld->getBoolConfig(CONFIG_MAP_PARALLEL_UPDATE) || sWorld->getIntConfig(CONFIG_NUMTHREADS) < 2)
+        return false;
+
+    // instance and battleground scripts keep map wide state that their creatures change from AI updates
+    if (Instanceable())
+        return false;
+
+    return sMapMgr->GetMapUpdater()->activated();
+}
+
+namespace
+{
+    // Units of a cell that fight, threaten, charm or own units in another grid, their updates change
+    // those units so the cell cannot be updated concurrently with that grid
+    class CrossRegionLinkCheck
+    {
+    public:
+        explicit CrossRegionLinkCheck(CellCoord const& cell) : _gridX(cell.x_coord / MAX_NUMBER_OF_CELLS), _gridY(cell.y_coord / MAX_NUMBER_OF_CELLS), _linked(false) { }
+
+        template<class T>
+        void Visit(GridRefManager<T>& m)
+        {
+            for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end() && !_linked; ++itr)
+                Check(itr->GetSource());
+        }
+
+        bool IsLinked() const { return _linked; }
+
+    private:
+        void Check(WorldObject* /*obj*/) { }
+
+        void Check(Unit* unit)
+        {
+            if (IsInOtherGrid(unit->GetVictim()) || IsInOtherGrid(unit->GetCharmerOrOwner()))
+            {
+                _linked = true;
+                return;
+            }
+
+            for (HostileReference* ref : unit->getThreatManager().getThreatList())
+            {
+                if (IsInOtherGrid(ref->getTarget()))
+                {
+                    _linked = true;
+                    return;
+                }
+            }
+
+            for (HostileReference* ref = unit->getHostileRefManager().getFirst(); ref; ref = ref->next())
+            {
+                if (IsInOtherGrid(ref->GetSource()->GetOwner()))
+                {
+                    _linked = true;
+                    return;
+                }
+            }
+        }
+
+        bool IsInOtherGrid(Unit const* other) const
+        {
+            if (!other)
+                return false;
+
+            CellCoord cell = Trinity::ComputeCellCoord(other->GetPositionX(), other->GetPositionY());
+            return cell.x_coord / MAX_NUMBER_OF_CELLS != _gridX || cell.y_coord / MAX_NUMBER_OF_CELLS != _gridY;
+        }
+
+        uint32 _gridX;
+        uint32 _gridY;
+        bool _linked;
+    };
+}
+
+void Map::UpdateCellsInRegions(std::vector<CellCoord>& cells, uint32 diff)
+{
+    // Cells this close to a grid border form the halo, they are updated serially once all regions are done
+    // so objects that interact with objects of a neighbouring grid never run concurrently with them
+    uint32 const borderCells = 1;
+
+    // Every grid without its halo is a region updated by a single thread. Grids are split in four passes by
+    // the parity of their coordinates (checkerboard), so regions updated at the same time are a full grid apart.
+    auto regionKey = [](CellCoord const& cell) -> uint64
+    {
+        uint32 gx = cell.x_coord / MAX_NUMBER_OF_CELLS;
+        uint32 gy = cell.y_coord / MAX_NUMBER_OF_CELLS;
+        uint64 pass = (gx & 1) | ((gy & 1) << 1);
+        return (pass << 32) | (uint64(gy * MAX_NUMBER_OF_GRIDS + gx) << 18) | cell.GetId();
+    };
+
+    // cells with units linked to another grid (combat, threat, charm, ownership) join the halo as well,
+    // a player and everything fighting it from other grids is never split between concurrent regions
+    auto isInRegion = [this, borderCells](CellCoord const& cell)
+    {
+        uint32 x = cell.x_coord % MAX_NUMBER_OF_CELLS;
+        uint32 y = cell.y_coord % MAX_NUMBER_OF_CELLS;
+        if (x < borderCells || x >= MAX_NUMBER_OF_CELLS - borderCells
+            || y < borderCells || y >= MAX_NUMBER_OF_CELLS - borderCells)
+            return false;
+
+        CrossRegionLinkCheck check(cell);
+        TypeContainerVisitor<CrossRegionLinkCheck, GridTypeMapContainer> gridCheck(check);
+        TypeContainerVisitor<CrossRegionLinkCheck, WorldTypeMapContainer> worldCheck(check);
+        Cell visitedCell(cell);
+        visitedCell.SetNoCreate();
+        Visit(visitedCell, gridCheck);
+        Visit(visitedCell, worldCheck);
+        return !check.IsLinked();
+    };
+
+    std::vector<CellCoord>::iterator haloBegin = std::partition(cells.begin(), cells.end(), isInRegion);
+
+    // sorting keeps the update order deterministic regardless of player iteration order
+    std::sort(cells.begin(), haloBegin, [&regionKey](CellCoord const& left, CellCoord const& right)
+    {
+        return regionKey(left) < regionKey(right);
+    });
+
+    std::sort(haloBegin, cells.end(), [](CellCoord const& left, CellCoord const& right)
+    {
+        return left.GetId() < right.GetId();
+    });
+
+    auto updateCells = [this, diff](std::vector<CellCoord>::const_iterator begin, std::vector<CellCoord>::const_iterator end)
+    {
+        Trinity::ObjectUpdater updater(diff);
+        TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+        TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+
+        for (; begin != end; ++begin)
+        {
+            Cell cell(*begin);
+            cell.SetNoCreate();
+            Visit(cell, grid_object_update);
+            Visit(cell, world_object_update);
+        }
+    };
+
+    std::vector<std::vector<CellCoord>::const_iterator> regionStarts;
+    for (std::vector<CellCoord>::const_iterator itr = cells.begin(); itr != haloBegin; ++itr)
+        if (regionStarts.empty() || (regionKey(*regionStarts.back()) >> 18) != (regionKey(*itr) >> 18))
+            regionStarts.push_back(itr);
+
+    // not worth the synchronization, fall back to the serial update
+    if (regionStarts.size() < sWorld->getIntConfig(CONFIG_MAP_PARALLEL_UPDATE_MIN_GRIDS))
+    {
+        updateCells(cells.begin(), cells.end());
+        return;
+    }
+
+    regionStarts.push_back(haloBegin);
+
+    std::vector<std::function<void()>> tasks;
+    for (size_t i = 0; i + 1 < regionStarts.size();)
+    {
+        uint64 pass = regionKey(*regionStarts[i]) >> 32;
+
+        tasks.clear();
+        for (; i + 1 < regionStarts.size() && (regionKey(*regionStarts[i]) >> 32) == pass; ++i)
+        {
+            std::vector<CellCoord>::const_iterator begin = regionStarts[i];
+            std::vector<CellCoord>::const_iterator end = regionStarts[i + 1];
+            tasks.push_back([&updateCells, begin, end]() { updateCells(begin, end); });
+        }
+
+        _regionUpdateInProgress = true;
+        sMapMgr->GetMapUpdater()->run_tasks(tasks);
+        _regionUpdateInProgress = false;
+    }
+
+    updateCells(haloBegin, cells.end());
+}
+
+void Map::RequestPath(std::shared_ptr<PathGenerator> const& path, float x, float y, float z, bool forceDest, std::function<void(bool)>&& callback)
+{
+    if (!_collectPathRequests)
+    {
+        callback(path->CalculatePath(x, y, z, forceDest));
+        return;
+    }
+
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+    _pathRequests.push_back({ path, x, y, z, forceDest, std::move(callback) });
+}
+
+void Map::ProcessPathRequests()
+{
+    _collectPathRequests = false;
+    if (_pathRequests.empty())
+        return;
+
+    std::vector<PathRequest> requests;
+    requests.swap(_pathRequests);
+
+    // generators destroyed since the request was made are skipped, the others are kept alive until the paths are calculated
+    std::vector<std::shared_ptr<PathGenerator>> paths(requests.size());
+    std::vector<uint8> results(requests.size(), 0);
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(requests.size());
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+        paths[i] = requests[i].Path.lock();
+        if (!paths[i])
+            continue;
+
+        PathRequest const& request = requests[i];
+        std::shared_ptr<PathGenerator> const& path = paths[i];
+        uint8& result = results[i];
+        tasks.push_back([&request, &path, &result]()
+        {
+            result = path->CalculatePath(request.X, request.Y, request.Z, request.ForceDestination) ? 1 : 0;
+        });
+    }
+
+    // objects do not change while this thread waits, path calculation only reads terrain and unit state
+    sMapMgr->GetMapUpdater()->run_tasks(tasks);
+
+    TC_METRIC_VALUE("map_path_requests", uint32(tasks.size()), TC_METRIC_TAG("map_id", std::to_string(GetId())));
+
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+        if (!paths[i])
+            continue;
+
+        // a callback may destroy the generator of a later request
+        paths[i].reset();
+        if (!requests[i].Path.expired())
+            requests[i].Callback(results[i] != 0);
+    }
+}
+
+bool Map::ConsumeUpdateDiff(uint32 diff, uint32& updateDiff)
+{
+    uint32 interval = sWorld->getIntConfig(CONFIG_MAP_EMPTY_INSTANCE_UPDATE_INTERVAL);
+    _postponedUpdateDiff += diff;
+
+    if (interval && !HavePlayers() && _postponedUpdateDiff < interval)
+        return false;
+
+    updateDiff = _postponedUpdateDiff;
+    _postponedUpdateDiff = 0;
+    return true;
+}
+
 void Map::Update(const uint32 t_diff)
 {
     _dynamicTree.update(t_diff);
@@ -769,6 +1067,19 @@ void Map::Update(const uint32 t_diff)
     // for pets
     TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
+    // cells are either updated right away or collected and split between MapUpdater workers
+    bool const updateInRegions = CanUpdateInRegions();
+    std::vector<CellCoord> regionCells;
+    auto updateNearbyCells = [&](WorldObject* obj)
+    {
+        if (updateInRegions)
+            CollectNearbyCellsOf(obj, regionCells);
+        else
+            VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+    };
+
+    _collectPathRequests = sWorld->getBoolConfig(CONFIG_MAP_BATCHED_PATHFINDING);
+
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -781,15 +1092,15 @@ void Map::Update(const uint32 t_diff)
         // update players at tick
         player->Update(t_diff);
 
-        VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+        updateNearbyCells(player);
 
         // If player is using far sight, visit that object too
         if (WorldObject* viewPoint = player->GetViewpoint())
         {
             if (Creature* viewCreature = viewPoint->ToCreature())
-                VisitNearbyCellsOf(viewCreature, grid_object_update, world_object_update);
+                updateNearbyCells(viewCreature);
             else if (DynamicObject* viewObject = viewPoint->ToDynObject())
-                VisitNearbyCellsOf(viewObject, grid_object_update, world_object_update);
+                updateNearbyCells(viewObject);
         }
 
         // Handle updates for creatures in combat with player and are more than 60 yards away
@@ -809,7 +1120,7 @@ void Map::Update(const uint32 t_diff)
 
             // Process deferred update list for player
             for (Creature* c : updateList)
-                VisitNearbyCellsOf(c, grid_object_update, world_object_update);
+                updateNearbyCells(c);
         }
     }
 
@@ -822,9 +1133,12 @@ void Map::Update(const uint32 t_diff)
         if (!obj || !obj->IsInWorld())
             continue;
 
-        VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+        updateNearbyCells(obj);
     }
 
+    if (updateInRegions)
+        UpdateCellsInRegions(regionCells, t_diff);
+
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
     {
         WorldObject* obj = *_transportsUpdateIter;
@@ -836,6 +1150,8 @@ void Map::Update(const uint32 t_diff)
         obj->Update(t_diff);
     }
 
+    ProcessPathRequests();
+
     SendObjectUpdates();
 
     ///- Process necessary scripts
@@ -974,6 +1290,8 @@ void Map::RemovePlayerFromMap(Player* player, bool remove)
 template<class T>
 void Map::RemoveFromMap(T *obj, bool remove)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+
     obj->RemoveFromWorld();
     if (obj->isActiveObject())
         RemoveFromActive(obj);
@@ -995,6 +1313,8 @@ void Map::RemoveFromMap(T *obj, bool remove)
 template<>
 void Map::RemoveFromMap(Transport* obj, bool remove)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+
     obj->RemoveFromWorld();
 
     Map::PlayerList const& players = GetPlayers();
@@ -1066,9 +1386,66 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
         AddToGrid(player, new_cell);
     }
 
+    PreloadTerrainAhead(player);
+
     player->UpdateObjectVisibility(false);
 }
 
+void Map::PreloadTerrainAhead(Player const* player)
+{
+    uint32 lookAhead = sWorld->getIntConfig(CONFIG_GRID_PRELOAD_LOOKAHEAD);
+    if (!lookAhead)
+        return;
+
+    GridMapPreloader* preloader = sMapMgr->GetGridMapPreloader();
+    if (!preloader->IsRunning())
+        return;
+
+    // taxi paths are sampled every two seconds, about a quarter of a grid at flight speed
+    uint32 const GridPreloadTimeStep = 2 * IN_MILLISECONDS;
+
+    auto request = [&](float x, float y)
+    {
+        GridCoord p = Trinity::ComputeGridCoord(x, y);
+        if (!p.IsCoordValid())
+            return;
+
+        int32 gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+        int32 gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+        if (!m_parentTerrainMap->GridMaps[gx][gy])
+            preloader->Request(m_parentTerrainMap->GetId(), gx, gy);
+    };
+
+    // taxi flights know exactly where they will be
+    if (player->IsInFlight() && player->movespline->Initialized() && !player->movespline->Finalized())
+    {
+        for (uint32 offset = GridPreloadTimeStep; offset <= lookAhead; offset += GridPreloadTimeStep)
+        {
+            Movement::Location location = player->movespline->ComputePosition(int32(offset));
+            request(location.x, location.y);
+        }
+        return;
+    }
+
+    if (!player->isMoving())
+        return;
+
+    UnitMoveType moveType = MOVE_RUN;
+    if (player->IsFlying())
+        moveType = MOVE_FLIGHT;
+    else if (player->IsInWater())
+        moveType = MOVE_SWIM;
+
+    // grids in visibility range of the predicted position get loaded too
+    float distance = player->GetSpeed(moveType) * lookAhead / IN_MILLISECONDS + GetVisibilityRange();
+    for (float step = SIZE_OF_GRIDS / 2; step < distance + SIZE_OF_GRIDS / 2; step += SIZE_OF_GRIDS / 2)
+    {
+        float traveled = std::min(step, distance);
+        request(player->GetPositionX() + traveled * std::cos(player->GetOrientation()),
+            player->GetPositionY() + traveled * std::sin(player->GetOrientation()));
+    }
+}
+
 void Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang, bool respawnRelocationOnFail)
 {
     ASSERT(CheckGridIntegrity(creature, false));
@@ -1206,6 +1583,8 @@ void Map::AreaTriggerRelocation(AreaTrigger* at, float x, float y, float z, floa
 
 void Map::AddCreatureToMoveList(Creature* c, float x, float y, float z, float ang)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+
     if (_creatureToMoveLock) //can this happen?
         return;
 
@@ -1216,6 +1595,8 @@ void Map::AddCreatureToMoveList(Creature* c, float x, float y, float z, float an
 
 void Map::RemoveCreatureFromMoveList(Creature* c)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+
     if (_creatureToMoveLock) //can this happen?
         return;
 
@@ -1225,6 +1606,8 @@ void Map::RemoveCreatureFromMoveList(Creature* c)
 
 void Map::AddGameObjectToMoveList(GameObject* go, float x, float y, float z, float ang)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+
     if (_gameObjectsToMoveLock) //can this happen?
         return;
 
@@ -1235,6 +1618,8 @@ void Map::AddGameObjectToMoveList(GameObject* go, float x, float y, float z, flo
 
 void Map::RemoveGameObjectFromMoveList(GameObject* go)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+
     if (_gameObjectsToMoveLock) //can this happen?
         return;
 
@@ -1244,6 +1629,8 @@ void Map::RemoveGameObjectFromMoveList(GameObject* go)
 
 void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj, float x, float y, float z, float ang)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+
     if (_dynamicObjectsToMoveLock) //can this happen?
         return;
 
@@ -1254,6 +1641,8 @@ void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj, float x, float y, fl
 
 void Map::RemoveDynamicObjectFromMoveList(DynamicObject* dynObj)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+
     if (_dynamicObjectsToMoveLock) //can this happen?
         return;
 
@@ -1263,6 +1652,8 @@ void Map::RemoveDynamicObjectFromMoveList(DynamicObject* dynObj)
 
 void Map::AddAreaTriggerToMoveList(AreaTrigger* at, float x, float y, float z, float ang)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+
     if (_areaTriggersToMoveLock) //can this happen?
         return;
 
@@ -1273,6 +1664,8 @@ void Map::AddAreaTriggerToMoveList(AreaTrigger* at, float x, float y, float z, f
 
 void Map::RemoveAreaTriggerFromMoveList(AreaTrigger* at)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+
     if (_areaTriggersToMoveLock) //can this happen?
         return;
 
@@ -1934,8 +2327,15 @@ bool GridMap::loadData(const char* filename)
         return false;
     }
 
-    if (header.mapMagic.asUInt == MapMagic.asUInt && header.versionMagic.asUInt == MapVersionMagic.asUInt)
+    if (header.mapMagic.asUInt == MapMagic.asUInt && (header.versionMagic.asUInt == MapVersionMagic.asUInt || header.versionMagic.asUInt == MapLegacyVersionMagic.asUInt))
     {
+        // point directly into the file if its arrays are suitably aligned, shares the pages between all processes using the file
+        if (mapData(filename, header))
+        {
+            fclose(in);
+            return true;
+        }
+
         // load up area data
         if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
         {
@@ -1967,15 +2367,34 @@ bool GridMap::loadData(const char* filename)
     return false;
 }
 
+void GridMap::prefetchData() const
+{
+    if (!_fileMapping)
+        return;
+
+    _fileMapping->advise(boost::interprocess::mapped_region::advice_willneed);
+
+    // the advice is only a hint, touch every page to have it read before the grid is handed out
+    uint8 const volatile* data = static_cast<uint8 const*>(_fileMapping->get_address());
+    std::size_t pageSize = boost::interprocess::mapped_region::get_page_size();
+    for (std::size_t offset = 0; offset < _fileMapping->get_size(); offset += pageSize)
+        (void)data[offset];
+}
+
 void GridMap::unloadData()
 {
-    delete[] _areaMap;
-    delete[] m_V9;
-    delete[] m_V8;
+    if (!_fileMapping)
+    {
+        delete[] _areaMap;
+        delete[] m_V9;
+        delete[] m_V8;
+        delete[] _liquidEntry;
+        delete[] _liquidFlags;
+        delete[] _liquidMap;
+    }
+
+    _fileMapping.reset();
     delete[] _minHeightPlanes;
-    delete[] _liquidEntry;
-    delete[] _liquidFlags;
-    delete[] _liquidMap;
     _areaMap = nullptr;
     m_V9 = nullptr;
     m_V8 = nullptr;
@@ -2057,43 +2476,48 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
             fread(minHeights.data(), sizeof(int16), minHeights.size(), in) != minHeights.size())
             return false;
 
-        static uint32 constexpr indices[8][3] =
-        {
-            { 3, 0, 4 },
-            { 0, 1, 4 },
-            { 1, 2, 4 },
-            { 2, 5, 4 },
-            { 5, 8, 4 },
-            { 8, 7, 4 },
-            { 7, 6, 4 },
-            { 6, 3, 4 }
-        };
-
-        static float constexpr boundGridCoords[9][2] =
-        {
-            { 0.0f, 0.0f },
-            { 0.0f, -266.66666f },
-            { 0.0f, -533.33331f },
-            { -266.66666f, 0.0f },
-            { -266.66666f, -266.66666f },
-            { -266.66666f, -533.33331f },
-            { -533.33331f, 0.0f },
-            { -533.33331f, -266.66666f },
-            { -533.33331f, -533.33331f }
-        };
-
-        _minHeightPlanes = new G3D::Plane[8];
-        for (uint32 quarterIndex = 0; quarterIndex < 8; ++quarterIndex)
-            _minHeightPlanes[quarterIndex] = G3D::Plane(
-                G3D::Vector3(boundGridCoords[indices[quarterIndex][0]][0], boundGridCoords[indices[quarterIndex][0]][1], minHeights[indices[quarterIndex][0]]),
-                G3D::Vector3(boundGridCoords[indices[quarterIndex][1]][0], boundGridCoords[indices[quarterIndex][1]][1], minHeights[indices[quarterIndex][1]]),
-                G3D::Vector3(boundGridCoords[indices[quarterIndex][2]][0], boundGridCoords[indices[quarterIndex][2]][1], minHeights[indices[quarterIndex][2]])
-            );
+        loadMinHeightPlanes(minHeights);
     }
 
     return true;
 }
 
+void GridMap::loadMinHeightPlanes(std::array<int16, 9> const& minHeights)
+{
+    static uint32 constexpr indices[8][3] =
+    {
+        { 3, 0, 4 },
+        { 0, 1, 4 },
+        { 1, 2, 4 },
+        { 2, 5, 4 },
+        { 5, 8, 4 },
+        { 8, 7, 4 },
+        { 7, 6, 4 },
+        { 6, 3, 4 }
+    };
+
+    static float constexpr boundGridCoords[9][2] =
+    {
+        { 0.0f, 0.0f },
+        { 0.0f, -266.66666f },
+        { 0.0f, -533.33331f },
+        { -266.66666f, 0.0f },
+        { -266.66666f, -266.66666f },
+        { -266.66666f, -533.33331f },
+        { -533.33331f, 0.0f },
+        { -533.33331f, -266.66666f },
+        { -533.33331f, -533.33331f }
+    };
+
+    _minHeightPlanes = new G3D::Plane[8];
+    for (uint32 quarterIndex = 0; quarterIndex < 8; ++quarterIndex)
+        _minHeightPlanes[quarterIndex] = G3D::Plane(
+            G3D::Vector3(boundGridCoords[indices[quarterIndex][0]][0], boundGridCoords[indices[quarterIndex][0]][1], minHeights[indices[quarterIndex][0]]),
+            G3D::Vector3(boundGridCoords[indices[quarterIndex][1]][0], boundGridCoords[indices[quarterIndex][1]][1], minHeights[indices[quarterIndex][1]]),
+            G3D::Vector3(boundGridCoords[indices[quarterIndex][2]][0], boundGridCoords[indices[quarterIndex][2]][1], minHeights[indices[quarterIndex][2]])
+        );
+}
+
 bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 {
     map_liquidHeader header;
@@ -2129,6 +2553,165 @@ bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
+namespace
+{
+    // array of count T stored at offset in the mapped file, nullptr if it would be out of bounds or misaligned
+    template<class T>
+    T* GetMappedArray(uint8 const* data, std::size_t size, std::size_t offset, std::size_t count)
+    {
+        if (offset > size || count > (size - offset) / sizeof(T) || reinterpret_cast<uintptr_t>(data + offset) % alignof(T))
+            return nullptr;
+
+        // mapping is read only, the grid never writes to its arrays
+        return const_cast<T*>(reinterpret_cast<T const*>(data + offset));
+    }
+
+    template<class Header>
+    bool ReadMappedHeader(uint8 const* data, std::size_t size, std::size_t offset, Header& header)
+    {
+        if (offset > size || size - offset < sizeof(Header))
+            return false;
+
+        memcpy(&header, data + offset, sizeof(Header));
+        return true;
+    }
+}
+
+bool GridMap::mapData(char const* filename, map_fileheader const& header)
+{
+    try
+    {
+        boost::interprocess::file_mapping file(filename, boost::interprocess::read_only);
+        _fileMapping = Trinity::make_unique<boost::interprocess::mapped_region>(file, boost::interprocess::read_only);
+    }
+    catch (boost::interprocess::interprocess_exception const& e)
+    {
+        TC_LOG_DEBUG("maps", "Could not map file '%s' (%s), reading it instead", filename, e.what());
+        _fileMapping.reset();
+        return false;
+    }
+
+    uint8 const* data = static_cast<uint8 const*>(_fileMapping->get_address());
+    std::size_t size = _fileMapping->get_size();
+    if ((!header.areaMapOffset || mapAreaData(data, size, header.areaMapOffset)) &&
+        (!header.heightMapOffset || mapHeightData(data, size, header.heightMapOffset)) &&
+        (!header.liquidMapOffset || mapLiquidData(data, size, header.liquidMapOffset)))
+        return true;
+
+    // file written without section alignment (or truncated), fall back to reading it
+    _fileMapping.reset();
+    delete[] _minHeightPlanes;
+    _areaMap = nullptr;
+    m_V9 = nullptr;
+    m_V8 = nullptr;
+    _minHeightPlanes = nullptr;
+    _liquidEntry = nullptr;
+    _liquidFlags = nullptr;
+    _liquidMap = nullptr;
+    _gridGetHeight = &GridMap::getHeightFromFlat;
+    return false;
+}
+
+bool GridMap::mapAreaData(uint8 const* data, std::size_t size, uint32 offset)
+{
+    map_areaHeader header;
+    if (!ReadMappedHeader(data, size, offset, header) || header.fourcc != MapAreaMagic.asUInt)
+        return false;
+
+    _gridArea = header.gridArea;
+    if (!(header.flags & MAP_AREA_NO_AREA))
+        if (!(_areaMap = GetMappedArray<uint16>(data, size, offset + sizeof(header), 16 * 16)))
+            return false;
+
+    return true;
+}
+
+bool GridMap::mapHeightData(uint8 const* data, std::size_t size, uint32 offset)
+{
+    map_heightHeader header;
+    if (!ReadMappedHeader(data, size, offset, header) || header.fourcc != MapHeightMagic.asUInt)
+        return false;
+
+    _gridHeight = header.gridHeight;
+    std::size_t arraysOffset = offset + sizeof(header);
+    std::size_t arraysSize = 0;
+    if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
+    {
+        if ((header.flags & MAP_HEIGHT_AS_INT16))
+        {
+            m_uint16_V9 = GetMappedArray<uint16>(data, size, arraysOffset, 129 * 129);
+            m_uint16_V8 = GetMappedArray<uint16>(data, size, arraysOffset + 129 * 129 * sizeof(uint16), 128 * 128);
+            arraysSize = (129 * 129 + 128 * 128) * sizeof(uint16);
+            _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
+            _gridGetHeight = &GridMap::getHeightFromUint16;
+        }
+        else if ((header.flags & MAP_HEIGHT_AS_INT8))
+        {
+            m_uint8_V9 = GetMappedArray<uint8>(data, size, arraysOffset, 129 * 129);
+            m_uint8_V8 = GetMappedArray<uint8>(data, size, arraysOffset + 129 * 129 * sizeof(uint8), 128 * 128);
+            arraysSize = (129 * 129 + 128 * 128) * sizeof(uint8);
+            _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
+            _gridGetHeight = &GridMap::getHeightFromUint8;
+        }
+        else
+        {
+            m_V9 = GetMappedArray<float>(data, size, arraysOffset, 129 * 129);
+            m_V8 = GetMappedArray<float>(data, size, arraysOffset + 129 * 129 * sizeof(float), 128 * 128);
+            arraysSize = (129 * 129 + 128 * 128) * sizeof(float);
+            _gridGetHeight = &GridMap::getHeightFromFloat;
+        }
+
+        if (!m_V9 || !m_V8)
+            return false;
+    }
+    else
+        _gridGetHeight = &GridMap::getHeightFromFlat;
+
+    if (header.flags & MAP_HEIGHT_HAS_FLIGHT_BOUNDS)
+    {
+        std::size_t boundsOffset = arraysOffset + arraysSize + 9 * sizeof(int16);   // max heights are not used
+        std::array<int16, 9> minHeights;
+        if (boundsOffset > size || size - boundsOffset < sizeof(minHeights))
+            return false;
+
+        memcpy(minHeights.data(), data + boundsOffset, sizeof(minHeights));
+        loadMinHeightPlanes(minHeights);
+    }
+
+    return true;
+}
+
+bool GridMap::mapLiquidData(uint8 const* data, std::size_t size, uint32 offset)
+{
+    map_liquidHeader header;
+    if (!ReadMappedHeader(data, size, offset, header) || header.fourcc != MapLiquidMagic.asUInt)
+        return false;
+
+    _liquidGlobalEntry = header.liquidType;
+    _liquidGlobalFlags = header.liquidFlags;
+    _liquidOffX  = header.offsetX;
+    _liquidOffY  = header.offsetY;
+    _liquidWidth = header.width;
+    _liquidHeight = header.height;
+    _liquidLevel  = header.liquidLevel;
+
+    std::size_t arraysOffset = offset + sizeof(header);
+    if (!(header.flags & MAP_LIQUID_NO_TYPE))
+    {
+        _liquidEntry = GetMappedArray<uint16>(data, size, arraysOffset, 16 * 16);
+        _liquidFlags = GetMappedArray<uint8>(data, size, arraysOffset + 16 * 16 * sizeof(uint16), 16 * 16);
+        if (!_liquidEntry || !_liquidFlags)
+            return false;
+
+        arraysOffset += 16 * 16 * (sizeof(uint16) + sizeof(uint8));
+    }
+    if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
+        if (!(_liquidMap = GetMappedArray<float>(data, size, arraysOffset, uint32(_liquidWidth) * uint32(_liquidHeight))))
+            return false;
+
+    return true;
+}
+
 uint16 GridMap::getArea(float x, float y) const
 {
     if (!_areaMap)
@@ -2683,7 +3266,12 @@ bool Map::GetAreaInfo(PhaseShift const& phaseShift, float x, float y, float z, u
     int32 dgroupId;
 
     bool hasVmapAreaInfo = vmgr->getAreaInfo(terrainMapId, x, y, vmap_z, vflags, vadtId, vrootId, vgroupId);
-    bool hasDynamicAreaInfo = _dynamicTree.getAreaInfo(x, y, dynamic_z, phaseShift, dflags, dadtId, drootId, dgroupId);
+    bool hasDynamicAreaInfo;
+    {
+        std::shared_lock<std::shared_timed_mutex> lock = LockForRegionRead(_dynamicTreeLock);
+        hasDynamicAreaInfo = _dynamicTree.getAreaInfo(x, y, dynamic_z, phaseShift, dflags, dadtId, drootId, dgroupId);
+    }
+
     auto useVmap = [&]() { check_z = vmap_z; flags = vflags; adtId = vadtId; rootId = vrootId; groupId = vgroupId; };
     auto useDyn = [&]() { check_z = dynamic_z; flags = dflags; adtId = dadtId; rootId = drootId; groupId = dgroupId; };
 
@@ -2881,8 +3469,18 @@ float Map::GetWaterLevel(PhaseShift const& phaseShift, float x, float y) const
 
 bool Map::isInLineOfSight(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(PhasingHandler::GetTerrainMapId(phaseShift, this, x1, y1), x1, y1, z1, x2, y2, z2)
-        && _dynamicTree.isInLineOfSight({ x1, y1, z1 }, { x2, y2, z2 }, phaseShift);
+    if (!VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(PhasingHandler::GetTerrainMapId(phaseShift, this, x1, y1), x1, y1, z1, x2, y2, z2))
+        return false;
+
+    std::shared_lock<std::shared_timed_mutex> lock = LockForRegionRead(_dynamicTreeLock);
+    return _dynamicTree.isInLineOfSight({ x1, y1, z1 }, { x2, y2, z2 }, phaseShift);
+}
+
+void Map::isInLineOfSight(PhaseShift const& phaseShift, float x1, float y1, float z1, G3D::Vector3 const* targets, uint32 count, bool* results) const
+{
+    VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(PhasingHandler::GetTerrainMapId(phaseShift, this, x1, y1), x1, y1, z1, targets, count, results);
+    std::shared_lock<std::shared_timed_mutex> lock = LockForRegionRead(_dynamicTreeLock);
+    _dynamicTree.isInLineOfSight({ x1, y1, z1 }, targets, count, results, phaseShift);
 }
 
 bool Map::getObjectHitPos(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist)
@@ -2891,7 +3489,11 @@ bool Map::getObjectHitPos(PhaseShift const& phaseShift, float x1, float y1, floa
     G3D::Vector3 dstPos(x2, y2, z2);
 
     G3D::Vector3 resultPos;
-    bool result = _dynamicTree.getObjectHitPos(startPos, dstPos, resultPos, modifyDist, phaseShift);
+    bool result;
+    {
+        std::shared_lock<std::shared_timed_mutex> lock = LockForRegionRead(_dynamicTreeLock);
+        result = _dynamicTree.getObjectHitPos(startPos, dstPos, resultPos, modifyDist, phaseShift);
+    }
 
     rx = resultPos.x;
     ry = resultPos.y;
@@ -2901,7 +3503,10 @@ bool Map::getObjectHitPos(PhaseShift const& phaseShift, float x1, float y1, floa
 
 float Map::GetHeight(PhaseShift const& phaseShift, float x, float y, float z, bool vmap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
 {
-    return std::max<float>(GetStaticHeight(phaseShift, x, y, z, vmap, maxSearchDist), _dynamicTree.getHeight(x, y, z, maxSearchDist, phaseShift));
+    float staticHeight = GetStaticHeight(phaseShift, x, y, z, vmap, maxSearchDist);
+
+    std::shared_lock<std::shared_timed_mutex> lock = LockForRegionRead(_dynamicTreeLock);
+    return std::max<float>(staticHeight, _dynamicTree.getHeight(x, y, z, maxSearchDist, phaseShift));
 }
 
 bool Map::IsInWater(PhaseShift const& phaseShift, float x, float y, float pZ, LiquidData* data) const
@@ -3038,24 +3643,70 @@ inline void Map::setNGrid(NGridType *grid, uint32 x, uint32 y)
     i_grids[x][y] = grid;
 }
 
+void Map::AddUpdateObject(Object* obj)
+{
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+    if (IsInUpdateObjects(obj))
+        return;
+
+    obj->SetUpdateObjectIndex(uint32(_updateObjects.size()));
+    _updateObjects.push_back(obj);
+}
+
+void Map::RemoveUpdateObject(Object* obj)
+{
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+    if (!IsInUpdateObjects(obj))
+        return;
+
+    // swap with the last entry so the list stays contiguous
+    uint32 index = obj->GetUpdateObjectIndex();
+    Object* last = _updateObjects.back();
+    _updateObjects[index] = last;
+    last->SetUpdateObjectIndex(index);
+    _updateObjects.pop_back();
+    obj->SetUpdateObjectIndex(UPDATE_OBJECT_INDEX_NONE);
+}
+
+bool Map::IsInUpdateObjects(Object* obj) const
+{
+    // the index stored in the object may belong to the list of another map (items follow their owner)
+    uint32 index = obj->GetUpdateObjectIndex();
+    return index < _updateObjects.size() && _updateObjects[index] == obj;
+}
+
 void Map::SendObjectUpdates()
 {
     UpdateDataMapType update_players;
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    std::size_t const updateObjectCount = _updateObjects.size();
+    _valuesUpdateBlocksBuilt = 0;
+    _valuesUpdateBlocksShared = 0;
 
     while (!_updateObjects.empty())
     {
-        Object* obj = *_updateObjects.begin();
+        Object* obj = _updateObjects.back();
         ASSERT(obj->IsInWorld());
-        _updateObjects.erase(_updateObjects.begin());
+        _updateObjects.pop_back();
+        if (obj->GetUpdateObjectIndex() == _updateObjects.size())
+            obj->SetUpdateObjectIndex(UPDATE_OBJECT_INDEX_NONE);
         obj->BuildUpdate(update_players);
     }
 
-    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
     for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
     {
+        WorldPacket packet;
         iter->second.BuildPacket(&packet);
-        iter->first->GetSession()->SendPacket(&packet);
-        packet.clear();                                     // clean the string
+        iter->first->GetSession()->SendPacket(std::move(packet));   // storage is handed over to the socket, no copy
+    }
+
+    if (updateObjectCount)
+    {
+        TC_METRIC_VALUE("map_object_updates", uint32(updateObjectCount), TC_METRIC_TAG("map_id", std::to_string(GetId())));
+        TC_METRIC_VALUE("map_values_update_blocks_built", _valuesUpdateBlocksBuilt, TC_METRIC_TAG("map_id", std::to_string(GetId())));
+        TC_METRIC_VALUE("map_values_update_blocks_shared", _valuesUpdateBlocksShared, TC_METRIC_TAG("map_id", std::to_string(GetId())));
+        TC_METRIC_VALUE("map_object_updates_time", uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count()),
+            TC_METRIC_TAG("map_id", std::to_string(GetId())));
     }
 }
 
@@ -3095,7 +3746,12 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
 
-    i_objectsToRemove.insert(obj);
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+    if (obj->IsInRemoveList())
+        return;
+
+    obj->SetInRemoveList(true);
+    i_objectsToRemove.push_back(obj);
     //TC_LOG_DEBUG("maps", "Object (GUID: %u TypeId: %u) added to removing list.", obj->GetGUIDLow(), obj->GetTypeId());
 }
 
@@ -3107,6 +3763,7 @@ void Map::AddObjectToSwitchList(WorldObject* obj, bool on)
     if (obj->GetTypeId() != TYPEID_UNIT && obj->GetTypeId() != TYPEID_GAMEOBJECT)
         return;
 
+    std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
     std::map<WorldObject*, bool>::iterator itr = i_objectsToSwitch.find(obj);
     if (itr == i_objectsToSwitch.end())
         i_objectsToSwitch.insert(itr, std::make_pair(obj, on));
@@ -3144,8 +3801,9 @@ void Map::RemoveAllObjectsInRemoveList()
     //TC_LOG_DEBUG("maps", "Object remover 1 check.");
     while (!i_objectsToRemove.empty())
     {
-        std::set<WorldObject*>::iterator itr = i_objectsToRemove.begin();
-        WorldObject* obj = *itr;
+        // the object keeps its remove list flag while being removed, so it can not be queued again before it is deleted
+        WorldObject* obj = i_objectsToRemove.back();
+        i_objectsToRemove.pop_back();
 
         switch (obj->GetTypeId())
         {
@@ -3153,7 +3811,10 @@ void Map::RemoveAllObjectsInRemoveList()
             {
                 Corpse* corpse = ObjectAccessor::GetCorpse(*obj, obj->GetGUID());
                 if (!corpse)
+                {
                     TC_LOG_ERROR("maps", "Tried to delete corpse/bones %s that is not in map.", obj->GetGUID().ToString().c_str());
+                    obj->SetInRemoveList(false);
+                }
                 else
                     RemoveFromMap(corpse, true);
                 break;
@@ -3187,10 +3848,9 @@ void Map::RemoveAllObjectsInRemoveList()
                 break;
             default:
                 TC_LOG_ERROR("maps", "Non-grid object (TypeId: %u) is in grid object remove list, ignored.", obj->GetTypeId());
+                obj->SetInRemoveList(false);
                 break;
         }
-
-        i_objectsToRemove.erase(itr);
     }
 
     //TC_LOG_DEBUG("maps", "Object remover 2 check.");
@@ -3207,8 +3867,12 @@ uint32 Map::GetPlayersCountExceptGMs() const
 
 void Map::SendToPlayers(WorldPacket const* data) const
 {
+    if (m_mapRefManager.isEmpty())
+        return;
+
+    BroadcastPacketPtr packet = std::make_shared<BroadcastPacket>(*data);
     for (MapRefManager::const_iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
-        itr->GetSource()->GetSession()->SendPacket(data);
+        itr->GetSource()->GetSession()->SendPacket(packet);
 }
 
 bool Map::ActiveObjectsNearGrid(NGridType const& ngrid) const
@@ -3964,41 +4628,49 @@ GameObject* Map::SummonGameObject(uint32 entry, Position const& pos, QuaternionD
 
 AreaTrigger* Map::GetAreaTrigger(ObjectGuid const& guid)
 {
+    std::shared_lock<std::shared_timed_mutex> lock = LockForRegionRead(_objectsStoreLock);
     return _objectsStore.Find<AreaTrigger>(guid);
 }
 
 SceneObject* Map::GetSceneObject(ObjectGuid const& guid)
 {
+    std::shared_lock<std::shared_timed_mutex> lock = LockForRegionRead(_objectsStoreLock);
     return _objectsStore.Find<SceneObject>(guid);
 }
 
 Conversation* Map::GetConversation(ObjectGuid const& guid)
 {
+    std::shared_lock<std::shared_timed_mutex> lock = LockForRegionRead(_objectsStoreLock);
     return _objectsStore.Find<Conversation>(guid);
 }
 
 Corpse* Map::GetCorpse(ObjectGuid const& guid)
 {
+    std::shared_lock<std::shared_timed_mutex> lock = LockForRegionRead(_objectsStoreLock);
     return _objectsStore.Find<Corpse>(guid);
 }
 
 Creature* Map::GetCreature(ObjectGuid const& guid)
 {
+    std::shared_lock<std::shared_timed_mutex> lock = LockForRegionRead(_objectsStoreLock);
     return _objectsStore.Find<Creature>(guid);
 }
 
 DynamicObject* Map::GetDynamicObject(ObjectGuid const& guid)
 {
+    std::shared_lock<std::shared_timed_mutex> lock = LockForRegionRead(_objectsStoreLock);
     return _objectsStore.Find<DynamicObject>(guid);
 }
 
 GameObject* Map::GetGameObject(ObjectGuid const& guid)
 {
+    std::shared_lock<std::shared_timed_mutex> lock = LockForRegionRead(_objectsStoreLock);
     return _objectsStore.Find<GameObject>(guid);
 }
 
 Pet* Map::GetPet(ObjectGuid const& guid)
 {
+    std::shared_lock<std::shared_timed_mutex> lock = LockForRegionRead(_objectsStoreLock);
     return _objectsStore.Find<Pet>(guid);
 }
 
@@ -4026,7 +4698,10 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType dbGuid, time_t respawnTime
         return;
     }
 
-    _creatureRespawnTimes[dbGuid] = respawnTime;
+    {
+        std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+        _creatureRespawnTimes[dbGuid] = respawnTime;
+    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CREATURE_RESPAWN);
     stmt->setUInt64(0, dbGuid);
@@ -4038,7 +4713,10 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType dbGuid, time_t respawnTime
 
 void Map::RemoveCreatureRespawnTime(ObjectGuid::LowType dbGuid)
 {
-    _creatureRespawnTimes.erase(dbGuid);
+    {
+        std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+        _creatureRespawnTimes.erase(dbGuid);
+    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CREATURE_RESPAWN);
     stmt->setUInt64(0, dbGuid);
@@ -4056,7 +4734,10 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType dbGuid, time_t respawnTime)
         return;
     }
 
-    _goRespawnTimes[dbGuid] = respawnTime;
+    {
+        std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+        _goRespawnTimes[dbGuid] = respawnTime;
+    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_GO_RESPAWN);
     stmt->setUInt64(0, dbGuid);
@@ -4068,7 +4749,10 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType dbGuid, time_t respawnTime)
 
 void Map::RemoveGORespawnTime(ObjectGuid::LowType dbGuid)
 {
-    _goRespawnTimes.erase(dbGuid);
+    {
+        std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+        _goRespawnTimes.erase(dbGuid);
+    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GO_RESPAWN);
     stmt->setUInt64(0, dbGuid);
@@ -23,6 +23,7 @@
 
 #include "GridDefines.h"
 #include "Cell.h"
+#include "Containers.h"
 #include "Timer.h"
 #include "SharedDefines.h"
 #include "GridRefManager.h"
@@ -30,11 +31,14 @@
 #include "DynamicTree.h"
 #include "ObjectGuid.h"
 
+#include <atomic>
 #include <bitset>
+#include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <unordered_set>
 
 class Battleground;
@@ -48,6 +52,8 @@ class InstanceScript;
 class InstanceScenario;
 class MapInstanced;
 class Object;
+class PathCorridorCache;
+class PathGenerator;
 class PhaseShift;
 class Player;
 class Spell;
@@ -68,7 +74,8 @@ enum Difficulty : uint8;
 enum WeatherState : uint32;
 
 namespace Trinity { struct ObjectUpdater; }
-namespace G3D { class Plane; }
+namespace G3D { class Plane; class Vector3; }
+namespace boost { namespace interprocess { class mapped_region; } }
 
 struct ScriptAction
 {
@@ -203,9 +210,18 @@ class TC_GAME_API GridMap
     uint8 _liquidHeight;
     bool _fileExists;
 
+    // when set the data arrays point into this read-only mapping of the map file instead of heap allocations
+    std::unique_ptr<boost::interprocess::mapped_region> _fileMapping;
+
     bool loadAreaData(FILE* in, uint32 offset, uint32 size);
     bool loadHeightData(FILE* in, uint32 offset, uint32 size);
     bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
+    void loadMinHeightPlanes(std::array<int16, 9> const& minHeights);
+
+    bool mapData(char const* filename, map_fileheader const& header);
+    bool mapAreaData(uint8 const* data, std::size_t size, uint32 offset);
+    bool mapHeightData(uint8 const* data, std::size_t size, uint32 offset);
+    bool mapLiquidData(uint8 const* data, std::size_t size, uint32 offset);
 
     // Get height functions and pointers
     typedef float (GridMap::*GetHeightPtr) (float x, float y) const;
@@ -220,6 +236,8 @@ public:
     ~GridMap();
     bool loadData(const char* filename);
     void unloadData();
+    // reads a mapped file into the page cache now, so the first lookups do not have to fault it in from disk
+    void prefetchData() const;
 
     uint16 getArea(float x, float y) const;
     inline float getHeight(float x, float y) const {return (this->*_gridGetHeight)(x, y);}
@@ -291,6 +309,14 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(const uint32);
 
+        // duration of the previous update in microseconds, MapUpdater schedules the most expensive maps first
+        uint32 GetLastUpdateTime() const { return _lastUpdateTime; }
+        void SetLastUpdateTime(uint32 updateTime) { _lastUpdateTime = updateTime; }
+
+        // empty instances may be updated less often, returns false while the update is postponed
+        // and the diff accumulated since the last real update otherwise
+        bool ConsumeUpdateDiff(uint32 diff, uint32& updateDiff);
+
         float GetVisibilityRange() const { return m_VisibleDistance; }
         //function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
@@ -430,8 +456,17 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         uint32 GetPlayersCountExceptGMs() const;
         bool ActiveObjectsNearGrid(NGridType const& ngrid) const;
 
-        void AddWorldObject(WorldObject* obj) { i_worldObjects.insert(obj); }
-        void RemoveWorldObject(WorldObject* obj) { i_worldObjects.erase(obj); }
+        void AddWorldObject(WorldObject* obj)
+        {
+            std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+            i_worldObjects.insert(obj);
+        }
+
+        void RemoveWorldObject(WorldObject* obj)
+        {
+            std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
+            i_worldObjects.erase(obj);
+        }
 
         void SendToPlayers(WorldPacket const* data) const;
 
@@ -470,12 +505,46 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         MapStoredObjectTypesContainer& GetObjectsStore() { return _objectsStore; }
 
+        template<class T>
+        void AddToObjectsStore(ObjectGuid const& guid, T* obj)
+        {
+            std::unique_lock<std::shared_timed_mutex> lock = LockForRegionWrite(_objectsStoreLock);
+            _objectsStore.Insert<T>(guid, obj);
+        }
+
+        template<class T>
+        void RemoveFromObjectsStore(ObjectGuid const& guid)
+        {
+            std::unique_lock<std::shared_timed_mutex> lock = LockForRegionWrite(_objectsStoreLock);
+            _objectsStore.Remove<T>(guid);
+        }
+
         typedef std::unordered_multimap<ObjectGuid::LowType, Creature*> CreatureBySpawnIdContainer;
         CreatureBySpawnIdContainer& GetCreatureBySpawnIdStore() { return _creatureBySpawnIdStore; }
 
         typedef std::unordered_multimap<ObjectGuid::LowType, GameObject*> GameObjectBySpawnIdContainer;
         GameObjectBySpawnIdContainer& GetGameObjectBySpawnIdStore() { return _gameobjectBySpawnIdStore; }
 
+        template<class T>
+        void AddToSpawnIdStore(ObjectGuid::LowType spawnId, T* obj)
+        {
+            std::unique_lock<std::shared_timed_mutex> lock = LockForRegionWrite(_spawnIdStoreLock);
+            GetSpawnIdStore<T>().insert(std::make_pair(spawnId, obj));
+        }
+
+        template<class T>
+        void RemoveFromSpawnIdStore(ObjectGuid::LowType spawnId, T* obj)
+        {
+            std::unique_lock<std::shared_timed_mutex> lock = LockForRegionWrite(_spawnIdStoreLock);
+            Trinity::Containers::MultimapErasePair(GetSpawnIdStore<T>(), spawnId, obj);
+        }
+
+        // Must be held around lookups in the spawn id stores made from object updates
+        std::shared_lock<std::shared_timed_mutex> LockSpawnIdStoresForRead() const { return LockForRegionRead(_spawnIdStoreLock); }
+
+        // True while UpdateCellsInRegions runs object updates on several threads
+        bool IsUpdatingInRegions() const { return _regionUpdateInProgress; }
+
         std::unordered_set<Corpse*> const* GetCorpsesInCell(uint32 cellId) const
         {
             auto itr = _corpsesByCell.find(cellId);
@@ -506,10 +575,20 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         float GetWaterOrGroundLevel(PhaseShift const& phaseShift, float x, float y, float z, float* ground = nullptr, bool swim = false) const;
         float GetHeight(PhaseShift const& phaseShift, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         bool isInLineOfSight(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2) const;
-        void Balance() { _dynamicTree.balance(); }
-        void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); }
-        void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); }
-        bool ContainsGameObjectModel(const GameObjectModel& model) const { return _dynamicTree.contains(model);}
+        // line of sight from one point to count targets at once, results[i] is set for targets[i]
+        void isInLineOfSight(PhaseShift const& phaseShift, float x1, float y1, float z1, G3D::Vector3 const* targets, uint32 count, bool* results) const;
+        void Balance() { std::unique_lock<std::shared_timed_mutex> lock = LockForRegionWrite(_dynamicTreeLock); _dynamicTree.balance(); }
+        void RemoveGameObjectModel(const GameObjectModel& model) { std::unique_lock<std::shared_timed_mutex> lock = LockForRegionWrite(_dynamicTreeLock); _dynamicTree.remove(model); }
+        void InsertGameObjectModel(const GameObjectModel& model) { std::unique_lock<std::shared_timed_mutex> lock = LockForRegionWrite(_dynamicTreeLock); _dynamicTree.insert(model); }
+        bool ContainsGameObjectModel(const GameObjectModel& model) const { std::shared_lock<std::shared_timed_mutex> lock = LockForRegionRead(_dynamicTreeLock); return _dynamicTree.contains(model);}
+        void GameObjectCollisionChanged() { std::unique_lock<std::shared_timed_mutex> lock = LockForRegionWrite(_dynamicTreeLock); _dynamicTree.collisionChanged(); }
+        uint32 GetDynamicCollisionGeneration() const { return _dynamicTree.getGeneration(); }
+
+        // Paths requested while the objects are updated are calculated together once all of them are, split between
+        // MapUpdater workers. The callback gets the result of PathGenerator::CalculatePath on the map thread and is
+        // not called if the generator was destroyed in the meantime. At most one pending request per generator.
+        void RequestPath(std::shared_ptr<PathGenerator> const& path, float x, float y, float z, bool forceDest, std::function<void(bool)>&& callback);
+        PathCorridorCache& GetPathCorridorCache() { return *_pathCorridorCache; }
         bool getObjectHitPos(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist);
 
         virtual ObjectGuid::LowType GetOwnerGuildId(uint32 /*team*/ = TEAM_OTHER) const { return UI64LIT(0); }
@@ -519,6 +598,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         time_t GetLinkedRespawnTime(ObjectGuid guid) const;
         time_t GetCreatureRespawnTime(ObjectGuid::LowType dbGuid) const
         {
+            std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
             std::unordered_map<ObjectGuid::LowType /*dbGUID*/, time_t>::const_iterator itr = _creatureRespawnTimes.find(dbGuid);
             if (itr != _creatureRespawnTimes.end())
                 return itr->second;
@@ -528,6 +608,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         time_t GetGORespawnTime(ObjectGuid::LowType dbGuid) const
         {
+            std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
             std::unordered_map<ObjectGuid::LowType /*dbGUID*/, time_t>::const_iterator itr = _goRespawnTimes.find(dbGuid);
             if (itr != _goRespawnTimes.end())
                 return itr->second;
@@ -569,20 +650,24 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         inline ObjectGuid::LowType GenerateLowGuid()
         {
             static_assert(ObjectGuidTraits<high>::MapSpecific, "Only map specific guid can be generated in Map context");
+            // generators are created on first use, regions may summon objects concurrently
+            std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
             return GetGuidSequenceGenerator<high>().Generate();
         }
 
-        void AddUpdateObject(Object* obj)
-        {
-            _updateObjects.insert(obj);
-        }
+        void AddUpdateObject(Object* obj);
+        void RemoveUpdateObject(Object* obj);
 
-        void RemoveUpdateObject(Object* obj)
+        // values update blocks serialized and reused across observers during SendObjectUpdates, reported as metrics
+        void AddValuesUpdateBlockCounts(uint32 built, uint32 shared)
         {
-            _updateObjects.erase(obj);
+            _valuesUpdateBlocksBuilt += built;
+            _valuesUpdateBlocksShared += shared;
         }
 
     private:
+        bool IsInUpdateObjects(Object* obj) const;
+
         void LoadMapAndVMap(int gx, int gy);
         void LoadVMap(int gx, int gy);
         void LoadMap(int gx, int gy);
@@ -590,6 +675,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void UnloadMap(int gx, int gy);
         static void UnloadMapImpl(Map* map, int gx, int gy);
         void LoadMMap(int gx, int gy);
+        void PreloadTerrainAhead(Player const* player);
         GridMap* GetGrid(float x, float y);
         GridMap* GetGrid(uint32 mapId, float x, float y);
 
@@ -646,6 +732,63 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         void SendObjectUpdates();
 
+        // Parallel update of a single map, grids are the regions handed out to MapUpdater workers
+        bool CanUpdateInRegions() const;
+        void CollectNearbyCellsOf(WorldObject* obj, std::vector<CellCoord>& cells);
+        void UpdateCellsInRegions(std::vector<CellCoord>& cells, uint32 diff);
+
+        // Serializes changes of map wide containers while UpdateCellsInRegions runs object updates on several threads
+        std::unique_lock<std::recursive_mutex> LockForRegionUpdate() const
+        {
+            if (!_regionUpdateInProgress)
+                return std::unique_lock<std::recursive_mutex>();
+
+            return std::unique_lock<std::recursive_mutex>(_regionUpdateLock);
+        }
+
+        // Containers read far more often than changed during object updates (guid lookups, collision),
+        // their locks are only held around the container access itself and never nested
+        std::shared_lock<std::shared_timed_mutex> LockForRegionRead(std::shared_timed_mutex& lock) const
+        {
+            if (!_regionUpdateInProgress)
+                return std::shared_lock<std::shared_timed_mutex>();
+
+            return std::shared_lock<std::shared_timed_mutex>(lock);
+        }
+
+        std::unique_lock<std::shared_timed_mutex> LockForRegionWrite(std::shared_timed_mutex& lock) const
+        {
+            if (!_regionUpdateInProgress)
+                return std::unique_lock<std::shared_timed_mutex>();
+
+            return std::unique_lock<std::shared_timed_mutex>(lock);
+        }
+
+        bool _regionUpdateInProgress;
+        mutable std::recursive_mutex _regionUpdateLock;
+        mutable std::shared_timed_mutex _objectsStoreLock;
+        mutable std::shared_timed_mutex _dynamicTreeLock;
+        mutable std::shared_timed_mutex _spawnIdStoreLock;
+
+        struct PathRequest
+        {
+            std::weak_ptr<PathGenerator> Path;
+            float X;
+            float Y;
+            float Z;
+            bool ForceDestination;
+            std::function<void(bool)> Callback;
+        };
+
+        void ProcessPathRequests();
+
+        std::vector<PathRequest> _pathRequests;
+        bool _collectPathRequests;
+        std::unique_ptr<PathCorridorCache> _pathCorridorCache;
+
+        std::atomic<uint32> _lastUpdateTime;
+        uint32 _postponedUpdateDiff;
+
     protected:
         virtual void LoadGridObjects(NGridType* grid, Cell const& cell);
 
@@ -701,7 +844,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void ProcessRelocationNotifies(const uint32 diff);
 
         bool i_scriptLock;
-        std::set<WorldObject*> i_objectsToRemove;
+        std::vector<WorldObject*> i_objectsToRemove;
         std::map<WorldObject*, bool> i_objectsToSwitch;
         std::set<WorldObject*> i_worldObjects;
 
@@ -717,11 +860,13 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         void AddToActiveHelper(WorldObject* obj)
         {
+            std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
             m_activeNonPlayers.insert(obj);
         }
 
         void RemoveFromActiveHelper(WorldObject* obj)
         {
+            std::unique_lock<std::recursive_mutex> lock = LockForRegionUpdate();
             // Map::Update for active object in proccess
             if (m_activeNonPlayersIter != m_activeNonPlayers.end())
             {
@@ -743,6 +888,9 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         IntervalTimer _weatherUpdateTimer;
         uint32 _defaultLight;
 
+        template<class T>
+        std::unordered_multimap<ObjectGuid::LowType, T*>& GetSpawnIdStore();
+
         template<HighGuid high>
         inline ObjectGuidGeneratorBase& GetGuidSequenceGenerator()
         {
@@ -761,9 +909,17 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         std::unordered_map<ObjectGuid, Corpse*> _corpsesByPlayer;
         std::unordered_set<Corpse*> _corpseBones;
 
-        std::unordered_set<Object*> _updateObjects;
+        std::vector<Object*> _updateObjects;
+        uint32 _valuesUpdateBlocksBuilt;
+        uint32 _valuesUpdateBlocksShared;
 };
 
+template<>
+inline Map::CreatureBySpawnIdContainer& Map::GetSpawnIdStore<Creature>() { return _creatureBySpawnIdStore; }
+
+template<>
+inline Map::GameObjectBySpawnIdContainer& Map::GetSpawnIdStore<GameObject>() { return _gameobjectBySpawnIdStore; }
+
 enum InstanceResetMethod
 {
     INSTANCE_RESET_ALL,
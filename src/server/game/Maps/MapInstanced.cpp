@@ -66,10 +66,14 @@ void MapInstanced::Update(const uint32 t)
         else
         {
             // update only here, because it may schedule some bad things before delete
-            if (sMapMgr->GetMapUpdater()->activated())
-                sMapMgr->GetMapUpdater()->schedule_update(*i->second, t);
-            else
-                i->second->Update(t);
+            uint32 diff;
+            if (i->second->ConsumeUpdateDiff(t, diff))
+            {
+                if (sMapMgr->GetMapUpdater()->activated())
+                    sMapMgr->GetMapUpdater()->schedule_update(*i->second, diff);
+                else
+                    i->second->Update(diff);
+            }
             ++i;
         }
     }
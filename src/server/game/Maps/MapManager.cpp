@@ -53,6 +53,9 @@ void MapManager::Initialize()
     // Start mtmaps if needed.
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    if (sWorld->getIntConfig(CONFIG_GRID_PRELOAD_LOOKAHEAD))
+        _gridMapPreloader.Start();
 }
 
 void MapManager::InitializeParentMapData(std::unordered_map<uint32, std::vector<uint32>> const& mapData)
@@ -293,6 +296,8 @@ void MapManager::UnloadAll()
     if (m_updater.activated())
         m_updater.deactivate();
 
+    _gridMapPreloader.Stop();
+
     Map::DeleteStateMachine();
 }
 
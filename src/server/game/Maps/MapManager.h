@@ -22,6 +22,7 @@
 #include "Object.h"
 #include "Map.h"
 #include "MapInstanced.h"
+#include "GridMapPreloader.h"
 #include "GridStates.h"
 #include "MapUpdater.h"
 
@@ -121,6 +122,7 @@ class TC_GAME_API MapManager
         void SetNextInstanceId(uint32 nextInstanceId) { _nextInstanceId = nextInstanceId; };
 
         MapUpdater * GetMapUpdater() { return &m_updater; }
+        GridMapPreloader* GetGridMapPreloader() { return &_gridMapPreloader; }
 
         template<typename Worker>
         void DoForAllMaps(Worker&& worker);
@@ -159,6 +161,7 @@ class TC_GAME_API MapManager
         InstanceIds _instanceIds;
         uint32 _nextInstanceId;
         MapUpdater m_updater;
+        GridMapPreloader _gridMapPreloader;
 
         // atomic op counter for active scripts amount
         std::atomic<std::size_t> _scheduledScripts;
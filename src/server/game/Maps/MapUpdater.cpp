@@ -18,37 +18,139 @@
 
 #include "MapUpdater.h"
 #include "Map.h"
+#include "Metric.h"
 
-#include <mutex>
+#include <algorithm>
+#include <chrono>
+#include <string>
 
+namespace
+{
+    // index of the current thread in MapUpdater::_workerQueues, only valid for worker threads of t_updater
+    thread_local MapUpdater const* t_updater = nullptr;
+    thread_local size_t t_workerIndex = 0;
+}
+
+class MapUpdaterTask
+{
+    public:
+        explicit MapUpdaterTask(uint32 cost = 0) : m_cost(cost) { }
+        virtual ~MapUpdaterTask() { }
+
+        virtual void call() = 0;
+
+        uint32 cost() const { return m_cost; }
 
-class MapUpdateRequest
+    private:
+        uint32 m_cost;
+};
+
+class MapUpdateRequest : public MapUpdaterTask
 {
     private:
 
         Map& m_map;
         MapUpdater& m_updater;
         uint32 m_diff;
+        std::chrono::steady_clock::time_point m_scheduleTime;
 
     public:
 
         MapUpdateRequest(Map& m, MapUpdater& u, uint32 d)
-            : m_map(m), m_updater(u), m_diff(d)
+            : MapUpdaterTask(m.GetLastUpdateTime()), m_map(m), m_updater(u), m_diff(d), m_scheduleTime(std::chrono::steady_clock::now())
         {
         }
 
-        void call()
+        void call() override
         {
+            using namespace std::chrono;
+
+            steady_clock::time_point startTime = steady_clock::now();
             m_map.Update (m_diff);
+            steady_clock::time_point endTime = steady_clock::now();
+
+            uint32 updateTime = uint32(duration_cast<microseconds>(endTime - startTime).count());
+            m_map.SetLastUpdateTime(updateTime);
+
+            // tagged by map id only, all instances of a map share one series so their number stays bounded
+            TC_METRIC_VALUE("map_update_time", updateTime, TC_METRIC_TAG("map_id", std::to_string(m_map.GetId())));
+            TC_METRIC_VALUE("map_update_queue_wait", uint32(duration_cast<microseconds>(startTime - m_scheduleTime).count()),
+                TC_METRIC_TAG("map_id", std::to_string(m_map.GetId())));
+
             m_updater.update_finished();
         }
 };
 
+// Shared between the thread calling MapUpdater::run_tasks and the helper requests it queues.
+// Helpers that are dequeued after all tasks were taken simply find nothing left to do.
+class MapTaskBatch
+{
+    private:
+
+        std::vector<std::function<void()>> const& m_tasks;
+        size_t const m_count;
+        std::atomic<size_t> m_next;
+        std::atomic<size_t> m_finished;
+        std::mutex m_lock;
+        std::condition_variable m_condition;
+
+    public:
+
+        explicit MapTaskBatch(std::vector<std::function<void()>> const& tasks)
+            : m_tasks(tasks), m_count(tasks.size()), m_next(0), m_finished(0)
+        {
+        }
+
+        void process()
+        {
+            for (size_t i = m_next++; i < m_count; i = m_next++)
+            {
+                m_tasks[i]();
+
+                if (++m_finished == m_count)
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    m_condition.notify_all();
+                }
+            }
+        }
+
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+
+            while (m_finished < m_count)
+                m_condition.wait(lock);
+        }
+};
+
+class MapTaskBatchRequest : public MapUpdaterTask
+{
+    private:
+
+        std::shared_ptr<MapTaskBatch> m_batch;
+
+    public:
+
+        explicit MapTaskBatchRequest(std::shared_ptr<MapTaskBatch> batch)
+            : m_batch(std::move(batch))
+        {
+        }
+
+        void call() override
+        {
+            m_batch->process();
+        }
+};
+
 void MapUpdater::activate(size_t num_threads)
 {
+    for (size_t i = 0; i < num_threads; ++i)
+        _workerQueues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+
     for (size_t i = 0; i < num_threads; ++i)
     {
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
     }
 }
 
@@ -58,16 +160,29 @@ void MapUpdater::deactivate()
 
     wait();
 
-    _queue.Cancel();
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        _queueCondition.notify_all();
+    }
 
     for (auto& thread : _workerThreads)
     {
         thread.join();
     }
+
+    for (std::unique_ptr<WorkerQueue>& queue : _workerQueues)
+    {
+        for (MapUpdaterTask* task : queue->Tasks)
+            delete task;
+
+        queue->Tasks.clear();
+    }
 }
 
 void MapUpdater::wait()
 {
+    dispatch_scheduled();
+
     std::unique_lock<std::mutex> lock(_lock);
 
     while (pending_requests > 0)
@@ -78,11 +193,124 @@ void MapUpdater::wait()
 
 void MapUpdater::schedule_update(Map& map, uint32 diff)
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    MapUpdateRequest* request = new MapUpdateRequest(map, *this, diff);
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        ++pending_requests;
+    }
+
+    // maps scheduled from inside another map update (instances) go straight to the workers
+    if (t_updater == this)
+        push_request(request);
+    else
+        _scheduledRequests.push_back(request);
+}
+
+void MapUpdater::dispatch_scheduled()
+{
+    if (_scheduledRequests.empty())
+        return;
+
+    // longest processing time first: expensive maps start right away on the least loaded worker
+    std::stable_sort(_scheduledRequests.begin(), _scheduledRequests.end(), [](MapUpdateRequest const* left, MapUpdateRequest const* right)
+    {
+        return left->cost() > right->cost();
+    });
+
+    for (MapUpdateRequest* request : _scheduledRequests)
+        push_request(request);
+
+    _scheduledRequests.clear();
+}
+
+void MapUpdater::push_request(MapUpdateRequest* request)
+{
+    size_t worker = 0;
+    for (size_t i = 1; i < _workerQueues.size(); ++i)
+        if (_workerQueues[i]->Load < _workerQueues[worker]->Load)
+            worker = i;
+
+    push_task(request, worker, false);
+}
+
+void MapUpdater::push_task(MapUpdaterTask* task, size_t worker, bool urgent)
+{
+    // counted before it becomes visible so pop_task never sees more tasks than the counter
+    ++_queuedTasks;
+
+    {
+        WorkerQueue& queue = *_workerQueues[worker];
+        std::lock_guard<std::mutex> lock(queue.Lock);
+
+        if (urgent)
+            queue.Tasks.push_front(task);
+        else
+        {
+            // keep each queue sorted by descending cost
+            auto itr = std::find_if(queue.Tasks.begin(), queue.Tasks.end(), [task](MapUpdaterTask const* queued)
+            {
+                return queued->cost() < task->cost();
+            });
+            queue.Tasks.insert(itr, task);
+        }
+
+        queue.Load += task->cost();
+    }
+
+    std::lock_guard<std::mutex> lock(_queueLock);
+    _queueCondition.notify_one();
+}
+
+MapUpdaterTask* MapUpdater::pop_task(size_t worker)
+{
+    MapUpdaterTask* task = nullptr;
+
+    {
+        WorkerQueue& queue = *_workerQueues[worker];
+        std::lock_guard<std::mutex> lock(queue.Lock);
+        if (!queue.Tasks.empty())
+        {
+            task = queue.Tasks.front();
+            queue.Tasks.pop_front();
+            queue.Load -= task->cost();
+        }
+    }
+
+    // nothing left in our own queue, steal the cheapest task of another worker
+    for (size_t i = 1; !task && i < _workerQueues.size(); ++i)
+    {
+        WorkerQueue& queue = *_workerQueues[(worker + i) % _workerQueues.size()];
+        std::lock_guard<std::mutex> lock(queue.Lock);
+        if (!queue.Tasks.empty())
+        {
+            task = queue.Tasks.back();
+            queue.Tasks.pop_back();
+            queue.Load -= task->cost();
+        }
+    }
 
-    ++pending_requests;
+    if (task)
+        --_queuedTasks;
 
-    _queue.Push(new MapUpdateRequest(map, *this, diff));
+    return task;
+}
+
+void MapUpdater::run_tasks(std::vector<std::function<void()>> const& tasks)
+{
+    if (tasks.empty())
+        return;
+
+    std::shared_ptr<MapTaskBatch> batch = std::make_shared<MapTaskBatch>(tasks);
+
+    // the calling thread is usually a worker itself, only wake up the others
+    size_t self = t_updater == this ? t_workerIndex : 0;
+    size_t helpers = std::min(tasks.size() - 1, _workerThreads.empty() ? 0 : _workerThreads.size() - 1);
+    for (size_t i = 0; i < helpers; ++i)
+        push_task(new MapTaskBatchRequest(batch), (self + 1 + i) % _workerQueues.size(), true);
+
+    batch->process();
+    batch->wait();
 }
 
 bool MapUpdater::activated()
@@ -99,16 +327,27 @@ void MapUpdater::update_finished()
     _condition.notify_all();
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::WorkerThread(size_t worker)
 {
+    t_updater = this;
+    t_workerIndex = worker;
+
     while (1)
     {
-        MapUpdateRequest* request = nullptr;
+        MapUpdaterTask* request = pop_task(worker);
+
+        if (!request)
+        {
+            std::unique_lock<std::mutex> lock(_queueLock);
+
+            while (_queuedTasks == 0 && !_cancelationToken)
+                _queueCondition.wait(lock);
 
-        _queue.WaitAndPop(request);
+            if (_cancelationToken)
+                return;
 
-        if (_cancelationToken)
-            return;
+            continue;
+        }
 
         request->call();
 
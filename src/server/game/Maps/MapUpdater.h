@@ -20,11 +20,16 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Define.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
-#include <condition_variable>
-#include "ProducerConsumerQueue.h"
+#include <vector>
 
+class MapUpdaterTask;
 class MapUpdateRequest;
 class Map;
 
@@ -32,13 +37,19 @@ class TC_GAME_API MapUpdater
 {
     public:
 
-        MapUpdater() : _cancelationToken(false), pending_requests(0) {}
+        MapUpdater() : _cancelationToken(false), _queuedTasks(0), pending_requests(0) {}
         ~MapUpdater() { };
 
         friend class MapUpdateRequest;
 
+        // Updates scheduled by the world thread are only dispatched to the workers in wait(),
+        // longest (by previous update time) first, so one expensive map cannot end up last.
         void schedule_update(Map& map, uint32 diff);
 
+        // Runs all tasks on the worker threads and returns once every one of them has finished.
+        // The calling thread takes part in the work, so this is safe to call from inside a map update.
+        void run_tasks(std::vector<std::function<void()>> const& tasks);
+
         void wait();
 
         void activate(size_t num_threads);
@@ -49,18 +60,39 @@ class TC_GAME_API MapUpdater
 
     private:
 
-        ProducerConsumerQueue<MapUpdateRequest*> _queue;
+        // Tasks of a single worker, the owner takes them from the front while idle workers steal from the back.
+        // Load is the sum of predicted costs still queued and is used to pick the least busy worker.
+        struct WorkerQueue
+        {
+            WorkerQueue() : Load(0) { }
+
+            std::mutex Lock;
+            std::deque<MapUpdaterTask*> Tasks;
+            std::atomic<uint64> Load;
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> _workerQueues;
+        std::vector<MapUpdateRequest*> _scheduledRequests;
 
         std::vector<std::thread> _workerThreads;
         std::atomic<bool> _cancelationToken;
 
+        std::mutex _queueLock;
+        std::condition_variable _queueCondition;
+        std::atomic<size_t> _queuedTasks;
+
         std::mutex _lock;
         std::condition_variable _condition;
         size_t pending_requests;
 
+        void push_task(MapUpdaterTask* task, size_t worker, bool urgent);
+        void push_request(MapUpdateRequest* request);
+        MapUpdaterTask* pop_task(size_t worker);
+        void dispatch_scheduled();
+
         void update_finished();
 
-        void WorkerThread();
+        void WorkerThread(size_t worker);
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
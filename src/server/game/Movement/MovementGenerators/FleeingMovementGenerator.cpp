@@ -19,6 +19,8 @@
 #include "Creature.h"
 #include "CreatureAI.h"
 #include "FleeingMovementGenerator.h"
+#include "Map.h"
+#include "MotionMaster.h"
 #include "PathGenerator.h"
 #include "ObjectAccessor.h"
 #include "MoveSplineInit.h"
@@ -61,17 +63,36 @@ void FleeingMovementGenerator<T>::_setTargetLocation(T* owner)
         return;
     }
 
-    PathGenerator path(owner);
-    path.SetPathLengthLimit(30.0f);
-    bool result = path.CalculatePath(x, y, z);
-    if (!result || (path.GetPathType() & PATHFIND_NOPATH))
+    i_path = std::make_shared<PathGenerator>(owner);
+    i_path->SetPathLengthLimit(30.0f);
+
+    i_pathPending = true;
+    owner->GetMap()->RequestPath(i_path, x, y, z, false, [this, owner](bool pathFound)
+    {
+        i_pathPending = false;
+        _moveByPath(owner, pathFound);
+    });
+}
+
+template<class T>
+void FleeingMovementGenerator<T>::_moveByPath(T* owner, bool pathFound)
+{
+    // stopped fleeing or got stunned while the path was calculated with the other requests of the map
+    if (owner->GetMotionMaster()->empty() || owner->GetMotionMaster()->top() != this ||
+        owner->HasUnitState(UNIT_STATE_ROOT | UNIT_STATE_STUNNED))
+    {
+        i_nextCheckTime.Reset(100);
+        return;
+    }
+
+    if (!pathFound || (i_path->GetPathType() & PATHFIND_NOPATH))
     {
         i_nextCheckTime.Reset(100);
         return;
     }
 
     Movement::MoveSplineInit init(owner);
-    init.MovebyPath(path.GetPath());
+    init.MovebyPath(i_path->GetPath());
     init.SetWalk(false);
     int32 traveltime = init.Launch();
     i_nextCheckTime.Reset(traveltime + urand(800, 1500));
@@ -165,7 +186,7 @@ bool FleeingMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     }
 
     i_nextCheckTime.Update(time_diff);
-    if (i_nextCheckTime.Passed() && owner->movespline->Finalized())
+    if (i_nextCheckTime.Passed() && !i_pathPending && owner->movespline->Finalized())
         _setTargetLocation(owner);
 
     return true;
@@ -177,6 +198,8 @@ template void FleeingMovementGenerator<Player>::_getPoint(Player*, float&, float
 template void FleeingMovementGenerator<Creature>::_getPoint(Creature*, float&, float&, float&);
 template void FleeingMovementGenerator<Player>::_setTargetLocation(Player*);
 template void FleeingMovementGenerator<Creature>::_setTargetLocation(Creature*);
+template void FleeingMovementGenerator<Player>::_moveByPath(Player*, bool);
+template void FleeingMovementGenerator<Creature>::_moveByPath(Creature*, bool);
 template void FleeingMovementGenerator<Player>::DoReset(Player*);
 template void FleeingMovementGenerator<Creature>::DoReset(Creature*);
 template bool FleeingMovementGenerator<Player>::DoUpdate(Player*, uint32);
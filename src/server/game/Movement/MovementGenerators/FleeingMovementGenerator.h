@@ -20,12 +20,15 @@
 #define TRINITY_FLEEINGMOVEMENTGENERATOR_H
 
 #include "MovementGenerator.h"
+#include <memory>
+
+class PathGenerator;
 
 template<class T>
 class FleeingMovementGenerator : public MovementGeneratorMedium< T, FleeingMovementGenerator<T> >
 {
     public:
-        FleeingMovementGenerator(ObjectGuid fright) : i_frightGUID(fright), i_nextCheckTime(0) { }
+        FleeingMovementGenerator(ObjectGuid fright) : i_frightGUID(fright), i_nextCheckTime(0), i_pathPending(false) { }
 
         void DoInitialize(T*);
         void DoFinalize(T*);
@@ -36,10 +39,13 @@ class FleeingMovementGenerator : public MovementGeneratorMedium< T, FleeingMovem
 
     private:
         void _setTargetLocation(T*);
+        void _moveByPath(T*, bool pathFound);
         void _getPoint(T*, float &x, float &y, float &z);
 
         ObjectGuid i_frightGUID;
         TimeTracker i_nextCheckTime;
+        std::shared_ptr<PathGenerator> i_path;
+        bool i_pathPending;     // requested from the map, calculated at the end of its update
 };
 
 class TimedFleeingMovementGenerator : public FleeingMovementGenerator<Creature>
@@ -21,6 +21,8 @@
 #include "Errors.h"
 #include "Creature.h"
 #include "CreatureAI.h"
+#include "Map.h"
+#include "MotionMaster.h"
 #include "World.h"
 #include "MoveSplineInit.h"
 #include "MoveSpline.h"
@@ -48,6 +50,9 @@ void TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T* owner, bool up
     if (owner->GetTypeId() == TYPEID_UNIT && owner->ToCreature()->IsFocusing(nullptr, true))
         return;
 
+    if (i_pathPending)
+        return;
+
     float x, y, z;
 
     if (updateDestination || !i_path)
@@ -99,14 +104,32 @@ void TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T* owner, bool up
     }
 
     if (!i_path)
-        i_path = new PathGenerator(owner);
+        i_path = std::make_shared<PathGenerator>(owner);
 
     // allow pets to use shortcut if no path found when following their master
     bool forceDest = (owner->GetTypeId() == TYPEID_UNIT && owner->ToCreature()->IsPet()
         && owner->HasUnitState(UNIT_STATE_FOLLOW));
 
-    bool result = i_path->CalculatePath(x, y, z, forceDest);
-    if (!result || (i_path->GetPathType() & PATHFIND_NOPATH))
+    i_pathPending = true;
+    owner->GetMap()->RequestPath(i_path, x, y, z, forceDest, [this, owner](bool pathFound)
+    {
+        i_pathPending = false;
+        _moveByPath(owner, pathFound);
+    });
+}
+
+template<class T, typename D>
+void TargetedMovementGeneratorMedium<T, D>::_moveByPath(T* owner, bool pathFound)
+{
+    // things may have changed while the path was calculated with the other requests of the map
+    if (owner->GetMotionMaster()->empty() || owner->GetMotionMaster()->top() != this ||
+        !i_target.isValid() || !i_target->IsInWorld() || owner->HasUnitState(UNIT_STATE_NOT_MOVE) || owner->IsMovementPreventedByCasting())
+    {
+        i_recalculateTravel = true;
+        return;
+    }
+
+    if (!pathFound || (i_path->GetPathType() & PATHFIND_NOPATH))
     {
         // can't reach target
         i_recalculateTravel = true;
@@ -196,7 +219,8 @@ bool TargetedMovementGeneratorMedium<T, D>::DoUpdate(T* owner, uint32 time_diff)
     if (i_recalculateTravel || targetMoved)
         _setTargetLocation(owner, targetMoved);
 
-    if (owner->movespline->Finalized())
+    // the spline of the previous path is finished but the new one has not been launched yet
+    if (!i_pathPending && owner->movespline->Finalized())
     {
         static_cast<D*>(this)->MovementInform(owner);
         if (i_angle == 0.f && !owner->HasInArc(0.01f, i_target.getTarget()))
@@ -338,6 +362,10 @@ template void TargetedMovementGeneratorMedium<Player, ChaseMovementGenerator<Pla
 template void TargetedMovementGeneratorMedium<Player, FollowMovementGenerator<Player> >::_setTargetLocation(Player*, bool);
 template void TargetedMovementGeneratorMedium<Creature, ChaseMovementGenerator<Creature> >::_setTargetLocation(Creature*, bool);
 template void TargetedMovementGeneratorMedium<Creature, FollowMovementGenerator<Creature> >::_setTargetLocation(Creature*, bool);
+template void TargetedMovementGeneratorMedium<Player, ChaseMovementGenerator<Player> >::_moveByPath(Player*, bool);
+template void TargetedMovementGeneratorMedium<Player, FollowMovementGenerator<Player> >::_moveByPath(Player*, bool);
+template void TargetedMovementGeneratorMedium<Creature, ChaseMovementGenerator<Creature> >::_moveByPath(Creature*, bool);
+template void TargetedMovementGeneratorMedium<Creature, FollowMovementGenerator<Creature> >::_moveByPath(Creature*, bool);
 template bool TargetedMovementGeneratorMedium<Player, ChaseMovementGenerator<Player> >::DoUpdate(Player*, uint32);
 template bool TargetedMovementGeneratorMedium<Player, FollowMovementGenerator<Player> >::DoUpdate(Player*, uint32);
 template bool TargetedMovementGeneratorMedium<Creature, ChaseMovementGenerator<Creature> >::DoUpdate(Creature*, uint32);
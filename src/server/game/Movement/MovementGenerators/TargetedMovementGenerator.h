@@ -39,12 +39,12 @@ class TargetedMovementGeneratorMedium : public MovementGeneratorMedium< T, D >,
 {
     protected:
         TargetedMovementGeneratorMedium(Unit* target, float offset, float angle) :
-            TargetedMovementGeneratorBase(target), i_path(NULL),
+            TargetedMovementGeneratorBase(target),
             i_recheckDistance(0), i_offset(offset), i_angle(angle),
-            i_recalculateTravel(false), i_targetReached(false)
+            i_recalculateTravel(false), i_targetReached(false), i_pathPending(false)
         {
         }
-        ~TargetedMovementGeneratorMedium() { delete i_path; }
+        ~TargetedMovementGeneratorMedium() { }
 
     public:
         bool DoUpdate(T*, uint32);
@@ -54,13 +54,15 @@ class TargetedMovementGeneratorMedium : public MovementGeneratorMedium< T, D >,
         bool IsReachable() const { return (i_path) ? (i_path->GetPathType() & PATHFIND_NORMAL) : true; }
     protected:
         void _setTargetLocation(T* owner, bool updateDestination);
+        void _moveByPath(T* owner, bool pathFound);
 
-        PathGenerator* i_path;
+        std::shared_ptr<PathGenerator> i_path;
         TimeTrackerSmall i_recheckDistance;
         float i_offset;
         float i_angle;
         bool i_recalculateTravel : 1;
         bool i_targetReached : 1;
+        bool i_pathPending : 1;     // requested from the map, calculated at the end of its update
 };
 
 template<class T>
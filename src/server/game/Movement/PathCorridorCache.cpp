@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathCorridorCache.h"
+#include "Timer.h"
+#include <boost/functional/hash.hpp>
+
+namespace
+{
+    // targets move, old corridors are rarely useful and may lead through tiles unloaded since
+    uint32 const CORRIDOR_LIFETIME = 5000;
+    std::size_t const MAX_CORRIDORS = 1024;
+}
+
+std::size_t PathCorridorCache::KeyHash::operator()(Key const& key) const
+{
+    std::size_t hash = 0;
+    boost::hash_combine(hash, key.NavMeshMapId);
+    boost::hash_combine(hash, key.IncludeFlags);
+    boost::hash_combine(hash, key.ExcludeFlags);
+    boost::hash_combine(hash, key.StartPoly);
+    boost::hash_combine(hash, key.EndPoly);
+    return hash;
+}
+
+bool PathCorridorCache::Find(Key const& key, uint32 generation, dtPolyRef* path, uint32& pathLength, uint32 maxPathLength)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    auto itr = _corridors.find(key);
+    if (itr == _corridors.end())
+        return false;
+
+    if (itr->second.Generation != generation || GetMSTimeDiffToNow(itr->second.StoreTime) > CORRIDOR_LIFETIME || itr->second.Path.size() > maxPathLength)
+    {
+        _corridors.erase(itr);
+        return false;
+    }
+
+    pathLength = uint32(itr->second.Path.size());
+    std::copy(itr->second.Path.begin(), itr->second.Path.end(), path);
+    return true;
+}
+
+void PathCorridorCache::Store(Key const& key, uint32 generation, dtPolyRef const* path, uint32 pathLength)
+{
+    uint32 now = getMSTime();
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    if (_corridors.size() >= MAX_CORRIDORS)
+        Prune(now);
+
+    Corridor& corridor = _corridors[key];
+    corridor.Path.assign(path, path + pathLength);
+    corridor.Generation = generation;
+    corridor.StoreTime = now;
+}
+
+void PathCorridorCache::Prune(uint32 now)
+{
+    // everything expires at the same age, when nothing is old enough just start over
+    if (getMSTimeDiff(_lastPruneTime, now) < CORRIDOR_LIFETIME)
+    {
+        _corridors.clear();
+        return;
+    }
+
+    for (auto itr = _corridors.begin(); itr != _corridors.end();)
+    {
+        if (getMSTimeDiff(itr->second.StoreTime, now) > CORRIDOR_LIFETIME)
+            itr = _corridors.erase(itr);
+        else
+            ++itr;
+    }
+
+    _lastPruneTime = now;
+    if (_corridors.size() >= MAX_CORRIDORS)
+        _corridors.clear();
+}
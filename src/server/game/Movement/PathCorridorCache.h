@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PathCorridorCache_h__
+#define PathCorridorCache_h__
+
+#include "Define.h"
+#include "DetourNavMesh.h"
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/// Polygon corridors recently found by PathGenerator on a map, units chasing the same target
+/// from the same polygon reuse them instead of running findPath again.
+class TC_GAME_API PathCorridorCache
+{
+public:
+    struct Key
+    {
+        uint32 NavMeshMapId;
+        uint16 IncludeFlags;
+        uint16 ExcludeFlags;
+        dtPolyRef StartPoly;
+        dtPolyRef EndPoly;
+
+        bool operator==(Key const& right) const
+        {
+            return NavMeshMapId == right.NavMeshMapId && IncludeFlags == right.IncludeFlags && ExcludeFlags == right.ExcludeFlags
+                && StartPoly == right.StartPoly && EndPoly == right.EndPoly;
+        }
+    };
+
+    PathCorridorCache() : _lastPruneTime(0) { }
+
+    /// Copies a corridor stored under the same dynamic collision generation into path, false if there is none
+    bool Find(Key const& key, uint32 generation, dtPolyRef* path, uint32& pathLength, uint32 maxPathLength);
+    void Store(Key const& key, uint32 generation, dtPolyRef const* path, uint32 pathLength);
+
+private:
+    struct KeyHash
+    {
+        std::size_t operator()(Key const& key) const;
+    };
+
+    struct Corridor
+    {
+        std::vector<dtPolyRef> Path;
+        uint32 Generation;
+        uint32 StoreTime;
+    };
+
+    void Prune(uint32 now);
+
+    std::mutex _lock;
+    std::unordered_map<Key, Corridor, KeyHash> _corridors;
+    uint32 _lastPruneTime;
+};
+
+#endif // PathCorridorCache_h__
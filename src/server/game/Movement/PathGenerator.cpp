@@ -27,26 +27,23 @@
 #include "MMapManager.h"
 #include "Map.h"
 #include "Metric.h"
+#include "PathCorridorCache.h"
 #include "PhasingHandler.h"
 
 ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(const Unit* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false),
     _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _straightLine(false),
-    _endPosition(G3D::Vector3::zero()), _sourceUnit(owner), _navMesh(NULL),
+    _endPosition(G3D::Vector3::zero()), _sourceUnit(owner), _navMeshMapId(0), _navMesh(NULL),
     _navMeshQuery(NULL)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
     TC_LOG_DEBUG("maps", "++ PathGenerator::PathGenerator for %s", _sourceUnit->GetGUID().ToString().c_str());
 
-    uint32 mapId = PhasingHandler::GetTerrainMapId(_sourceUnit->GetPhaseShift(), _sourceUnit->GetMap(), _sourceUnit->GetPositionX(), _sourceUnit->GetPositionY());
+    _navMeshMapId = PhasingHandler::GetTerrainMapId(_sourceUnit->GetPhaseShift(), _sourceUnit->GetMap(), _sourceUnit->GetPositionX(), _sourceUnit->GetPositionY());
     if (DisableMgr::IsPathfindingEnabled(_sourceUnit->GetMapId()))
-    {
-        MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
-        _navMesh = mmap->GetNavMesh(mapId);
-        _navMeshQuery = mmap->GetNavMeshQuery(mapId, _sourceUnit->GetInstanceId());
-    }
+        _navMesh = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMesh(_navMeshMapId);
 
     CreateFilter();
 }
@@ -90,6 +87,13 @@ bool PathGenerator::CalculatePath(G3D::Vector3 start, G3D::Vector3 dest, bool fo
 
     TC_LOG_DEBUG("maps", "++ PathGenerator::CalculatePath() for %s", _sourceUnit->GetGUID().ToString().c_str());
 
+    // pooled query, lets paths of the same map be calculated from several threads at once
+    MMAP::NavMeshQueryHandle navMeshQuery;
+    if (_navMesh)
+        navMeshQuery = MMAP::MMapFactory::createOrGetMMapManager()->AcquireNavMeshQuery(_navMeshMapId);
+
+    _navMeshQuery = navMeshQuery.get();
+
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
     if (!_navMesh || !_navMeshQuery || _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING) ||
@@ -97,12 +101,14 @@ bool PathGenerator::CalculatePath(G3D::Vector3 start, G3D::Vector3 dest, bool fo
     {
         BuildShortcut();
         _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+        _navMeshQuery = nullptr;
         return true;
     }
 
     UpdateFilter();
 
     BuildPolyPath(start, dest);
+    _navMeshQuery = nullptr;
     return true;
 }
 
@@ -457,15 +463,28 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
-                            startPoly,          // start polygon
-                            endPoly,            // end polygon
-                            startPoint,         // start position
-                            endPoint,           // end position
-                            &_filter,           // polygon search filter
-                            _pathPolyRefs,     // [out] path
-                            (int*)&_polyLength,
-                            MAX_PATH_LENGTH);   // max number of polygons in output path
+            // units chasing the same target from the same polygon share the corridor
+            PathCorridorCache& corridorCache = _sourceUnit->GetMap()->GetPathCorridorCache();
+            PathCorridorCache::Key corridorKey = { _navMeshMapId, _filter.getIncludeFlags(), _filter.getExcludeFlags(), startPoly, endPoly };
+            uint32 collisionGeneration = _sourceUnit->GetMap()->GetDynamicCollisionGeneration();
+            if (corridorCache.Find(corridorKey, collisionGeneration, _pathPolyRefs, _polyLength, MAX_PATH_LENGTH) && IsValidCorridor())
+                dtResult = DT_SUCCESS;
+            else
+            {
+                dtResult = _navMeshQuery->findPath(
+                                startPoly,          // start polygon
+                                endPoly,            // end polygon
+                                startPoint,         // start position
+                                endPoint,           // end position
+                                &_filter,           // polygon search filter
+                                _pathPolyRefs,     // [out] path
+                                (int*)&_polyLength,
+                                MAX_PATH_LENGTH);   // max number of polygons in output path
+
+                // only complete corridors, partial ones depend on where the search gave up
+                if (_polyLength && dtStatusSucceed(dtResult) && !dtStatusDetail(dtResult, DT_PARTIAL_RESULT))
+                    corridorCache.Store(corridorKey, collisionGeneration, _pathPolyRefs, _polyLength);
+            }
         }
 
         if (!_polyLength || dtStatusFailed(dtResult))
@@ -680,6 +699,16 @@ NavTerrainFlag PathGenerator::GetNavTerrain(float x, float y, float z)
     }
 }
 
+bool PathGenerator::IsValidCorridor() const
+{
+    // tiles may have been reloaded since the corridor was stored
+    for (uint32 i = 0; i < _polyLength; ++i)
+        if (!_navMesh->isValidPolyRef(_pathPolyRefs[i]))
+            return false;
+
+    return true;
+}
+
 bool PathGenerator::HaveTile(const G3D::Vector3& p) const
 {
     int tx = -1, ty = -1;
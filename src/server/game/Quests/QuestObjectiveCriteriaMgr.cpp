@@ -328,3 +328,8 @@ CriteriaList const& QuestObjectiveCriteriaMgr::GetCriteriaByType(CriteriaTypes t
 {
     return sCriteriaMgr->GetQuestObjectiveCriteriaByType(type);
 }
+
+CriteriaList const& QuestObjectiveCriteriaMgr::GetCriteriaByAsset(CriteriaTypes type, uint32 asset) const
+{
+    return sCriteriaMgr->GetQuestObjectiveCriteriaByAsset(type, asset);
+}
@@ -56,6 +56,7 @@ protected:
 
     std::string GetOwnerInfo() const override;
     CriteriaList const& GetCriteriaByType(CriteriaTypes type) const override;
+    CriteriaList const& GetCriteriaByAsset(CriteriaTypes type, uint32 asset) const override;
 
 private:
     Player* _owner;
@@ -306,6 +306,11 @@ CriteriaList const& Scenario::GetCriteriaByType(CriteriaTypes type) const
     return sCriteriaMgr->GetScenarioCriteriaByType(type);
 }
 
+CriteriaList const& Scenario::GetCriteriaByAsset(CriteriaTypes type, uint32 asset) const
+{
+    return sCriteriaMgr->GetScenarioCriteriaByAsset(type, asset);
+}
+
 void Scenario::SendBootPlayer(Player* player)
 {
     WorldPackets::Scenario::ScenarioBoot scenarioBoot;
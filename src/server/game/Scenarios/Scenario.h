@@ -96,6 +96,7 @@ class TC_GAME_API Scenario : public CriteriaHandler
         std::vector<WorldPackets::Achievement::CriteriaProgress> GetCriteriasProgress();
 
         CriteriaList const& GetCriteriaByType(CriteriaTypes type) const override;
+        CriteriaList const& GetCriteriaByAsset(CriteriaTypes type, uint32 asset) const override;
         ScenarioData const* _data;
         Ashamane::AnyData Variables;
 
@@ -1056,6 +1056,123 @@ public:
     }
 };
 
+/// This hook is responsible for building the per opcode tables of ServerScript packet hooks
+template<typename Base>
+class ScriptRegistrySwapHooks<ServerScript, Base>
+    : public ScriptRegistrySwapHookBase
+{
+public:
+    struct PacketSubscribers
+    {
+        PacketSubscribers() : Invocations(0) { }
+
+        std::vector<ServerScript*> Scripts;
+        std::atomic<uint64> Invocations;
+    };
+
+    typedef std::unordered_map<uint32 /*opcode*/, PacketSubscribers> PacketSubscribersMap;
+
+    void BeforeReleaseContext(std::string const& context) final override
+    {
+        BuildPacketSubscribers(&context);
+    }
+
+    void BeforeSwapContext(bool /*initialize*/) override
+    {
+        // scripts subscribe from their constructors, which all ran by now
+        BuildPacketSubscribers(nullptr);
+    }
+
+    void BeforeUnload() final override
+    {
+        LogPacketHookInvocations();
+        _sendSubscribers.clear();
+        _receiveSubscribers.clear();
+        _allSendScripts.clear();
+        _allReceiveScripts.clear();
+    }
+
+    PacketSubscribers* GetPacketSendSubscribers(uint32 opcode)
+    {
+        return GetPacketSubscribers(_sendSubscribers, opcode);
+    }
+
+    PacketSubscribers* GetPacketReceiveSubscribers(uint32 opcode)
+    {
+        return GetPacketSubscribers(_receiveSubscribers, opcode);
+    }
+
+    // scripts that subscribed to every packet
+    std::vector<ServerScript*> const& GetAllPacketSendScripts() const { return _allSendScripts; }
+    std::vector<ServerScript*> const& GetAllPacketReceiveScripts() const { return _allReceiveScripts; }
+
+private:
+    static PacketSubscribers* GetPacketSubscribers(PacketSubscribersMap& subscribers, uint32 opcode)
+    {
+        if (subscribers.empty())
+            return nullptr;
+
+        auto itr = subscribers.find(opcode);
+        return itr != subscribers.end() ? &itr->second : nullptr;
+    }
+
+    void BuildPacketSubscribers(std::string const* releasedContext)
+    {
+        LogPacketHookInvocations();
+        _sendSubscribers.clear();
+        _receiveSubscribers.clear();
+        _allSendScripts.clear();
+        _allReceiveScripts.clear();
+
+        for (auto const& script : static_cast<Base*>(this)->_scripts)
+        {
+            if (releasedContext && script.first == *releasedContext)
+                continue;
+
+            ServerScript* serverScript = script.second.get();
+            if (serverScript->IsSubscribedToAllPacketSends())
+            {
+                _allSendScripts.push_back(serverScript);
+                if (serverScript->MarkAllPacketSendsReported())
+                    TC_LOG_WARN("scripts", "ServerScript %s subscribed to all sent packets, every packet is copied for it.", serverScript->GetName().c_str());
+            }
+            else
+            {
+                for (OpcodeServer opcode : serverScript->GetSubscribedSendOpcodes())
+                    _sendSubscribers[opcode].Scripts.push_back(serverScript);
+            }
+
+            if (serverScript->IsSubscribedToAllPacketReceives())
+            {
+                _allReceiveScripts.push_back(serverScript);
+                if (serverScript->MarkAllPacketReceivesReported())
+                    TC_LOG_WARN("scripts", "ServerScript %s subscribed to all received packets, every packet is copied for it.", serverScript->GetName().c_str());
+            }
+            else
+            {
+                for (OpcodeClient opcode : serverScript->GetSubscribedReceiveOpcodes())
+                    _receiveSubscribers[opcode].Scripts.push_back(serverScript);
+            }
+        }
+    }
+
+    void LogPacketHookInvocations() const
+    {
+        for (auto const& subscribers : _sendSubscribers)
+            TC_LOG_DEBUG("scripts", "ServerScript::OnPacketSend was called " UI64FMTD " times for %s",
+                subscribers.second.Invocations.load(), GetOpcodeNameForLogging(OpcodeServer(subscribers.first)).c_str());
+
+        for (auto const& subscribers : _receiveSubscribers)
+            TC_LOG_DEBUG("scripts", "ServerScript::OnPacketReceive was called " UI64FMTD " times for %s",
+                subscribers.second.Invocations.load(), GetOpcodeNameForLogging(OpcodeClient(subscribers.first)).c_str());
+    }
+
+    PacketSubscribersMap _sendSubscribers;
+    PacketSubscribersMap _receiveSubscribers;
+    std::vector<ServerScript*> _allSendScripts;
+    std::vector<ServerScript*> _allReceiveScripts;
+};
+
 // Database unbound script registry
 template<typename ScriptType>
 class SpecializedScriptRegistry<ScriptType, false>
@@ -1463,22 +1580,44 @@ void ScriptMgr::OnSocketClose(std::shared_ptr<WorldSocket> socket)
 
 void ScriptMgr::OnPacketReceive(WorldSession* session, WorldPacket const& packet)
 {
-    if (SCR_REG_LST(ServerScript).empty())
+    auto registry = ScriptRegistry<ServerScript>::Instance();
+    auto subscribers = registry->GetPacketReceiveSubscribers(packet.GetOpcode());
+    std::vector<ServerScript*> const& allPackets = registry->GetAllPacketReceiveScripts();
+    if (!subscribers && allPackets.empty())
         return;
 
     WorldPacket copy(packet);
-    FOREACH_SCRIPT(ServerScript)->OnPacketReceive(session, copy);
+    if (subscribers)
+    {
+        ++subscribers->Invocations;
+        for (ServerScript* script : subscribers->Scripts)
+            script->OnPacketReceive(session, copy);
+    }
+
+    for (ServerScript* script : allPackets)
+        script->OnPacketReceive(session, copy);
 }
 
 void ScriptMgr::OnPacketSend(WorldSession* session, WorldPacket const& packet)
 {
     ASSERT(session);
 
-    if (SCR_REG_LST(ServerScript).empty())
+    auto registry = ScriptRegistry<ServerScript>::Instance();
+    auto subscribers = registry->GetPacketSendSubscribers(packet.GetOpcode());
+    std::vector<ServerScript*> const& allPackets = registry->GetAllPacketSendScripts();
+    if (!subscribers && allPackets.empty())
         return;
 
     WorldPacket copy(packet);
-    FOREACH_SCRIPT(ServerScript)->OnPacketSend(session, copy);
+    if (subscribers)
+    {
+        ++subscribers->Invocations;
+        for (ServerScript* script : subscribers->Scripts)
+            script->OnPacketSend(session, copy);
+    }
+
+    for (ServerScript* script : allPackets)
+        script->OnPacketSend(session, copy);
 }
 
 void ScriptMgr::OnOpenStateChange(bool open)
@@ -3045,7 +3184,7 @@ SpellScriptLoader::SpellScriptLoader(const char* name)
 }
 
 ServerScript::ServerScript(const char* name)
-    : ScriptObject(name)
+    : ScriptObject(name), _allPacketSends(false), _allPacketReceives(false), _allPacketSendsReported(false), _allPacketReceivesReported(false)
 {
     ScriptRegistry<ServerScript>::Instance()->AddScript(this);
 }
@@ -21,6 +21,7 @@
 
 #include "Common.h"
 #include "ObjectGuid.h"
+#include <utility>
 #include <vector>
 #include <boost/property_tree/ptree.hpp>
 #include "MovementInfo.h"
@@ -96,6 +97,8 @@ struct SkillLineEntry;
 enum BattlegroundTypeId : uint32;
 enum Difficulty : uint8;
 enum DuelCompleteType : uint8;
+enum OpcodeClient : uint16;
+enum OpcodeServer : uint16;
 enum Powers : int8;
 enum QuestStatus : uint8;
 enum RemoveMethod : uint8;
@@ -257,13 +260,47 @@ class TC_GAME_API ServerScript : public ScriptObject
         // being open; it is not.
         virtual void OnSocketClose(std::shared_ptr<WorldSocket> /*socket*/) { }
 
-        // Called when a packet is sent to a client. The packet object is a copy of the original packet, so reading
-        // and modifying it is safe.
+        // Called when a packet with an opcode subscribed to by SubscribeToPacketSend, or any packet after
+        // SubscribeToAllPacketSends, is sent to a client. The packet object is a copy of the original packet,
+        // so reading and modifying it is safe. Scripts without any subscription are never called.
         virtual void OnPacketSend(WorldSession* /*session*/, WorldPacket& /*packet*/) { }
 
-        // Called when a (valid) packet is received by a client. The packet object is a copy of the original packet, so
-        // reading and modifying it is safe. Make sure to check WorldSession pointer before usage, it might be null in case of auth packets
+        // Called when a (valid) packet with an opcode subscribed to by SubscribeToPacketReceive, or any packet after
+        // SubscribeToAllPacketReceives, is received by a client. The packet object is a copy of the original packet,
+        // so reading and modifying it is safe. Make sure to check WorldSession pointer before usage, it might be null
+        // in case of auth packets. Scripts without any subscription are never called.
         virtual void OnPacketReceive(WorldSession* /*session*/, WorldPacket& /*packet*/) { }
+
+        std::vector<OpcodeServer> const& GetSubscribedSendOpcodes() const { return _sendOpcodes; }
+        std::vector<OpcodeClient> const& GetSubscribedReceiveOpcodes() const { return _receiveOpcodes; }
+
+        bool IsSubscribedToAllPacketSends() const { return _allPacketSends; }
+        bool IsSubscribedToAllPacketReceives() const { return _allPacketReceives; }
+
+        // Return true only for the first call, used to warn once about a script getting every packet
+        bool MarkAllPacketSendsReported() { return !std::exchange(_allPacketSendsReported, true); }
+        bool MarkAllPacketReceivesReported() { return !std::exchange(_allPacketReceivesReported, true); }
+
+    protected:
+
+        // Packets are only copied for and passed to the scripts subscribed to their opcode, subscribe from the constructor
+        void SubscribeToPacketSend(OpcodeServer opcode) { _sendOpcodes.push_back(opcode); }
+        void SubscribeToPacketReceive(OpcodeClient opcode) { _receiveOpcodes.push_back(opcode); }
+
+        // Every packet is copied for these scripts, meant for packet logging and debugging scripts only
+        void SubscribeToAllPacketSends() { _allPacketSends = true; }
+        void SubscribeToAllPacketReceives() { _allPacketReceives = true; }
+
+    private:
+
+        std::vector<OpcodeServer> _sendOpcodes;
+        std::vector<OpcodeClient> _receiveOpcodes;
+        bool _allPacketSends;
+        bool _allPacketReceives;
+
+        // set by the registry when it is rebuilt on the world thread
+        bool _allPacketSendsReported;
+        bool _allPacketReceivesReported;
 };
 
 class TC_GAME_API WorldScript : public ScriptObject
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BroadcastPacket.h"
+#include "Log.h"
+#include "World.h"
+#include "WorldSocket.h"
+#include <zlib.h>
+
+namespace
+{
+    // one deflate stream per broadcasting thread, reset for every packet so its output has no history
+    struct BroadcastCompressionStream
+    {
+        BroadcastCompressionStream() : Initialized(false)
+        {
+            Stream.zalloc = (alloc_func)NULL;
+            Stream.zfree = (free_func)NULL;
+            Stream.opaque = (voidpf)NULL;
+            Stream.avail_in = 0;
+            Stream.next_in = NULL;
+            int32 z_res = deflateInit2(&Stream, sWorld->getIntConfig(CONFIG_COMPRESSION), Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+            if (z_res != Z_OK)
+            {
+                TC_LOG_ERROR("network", "Can't initialize broadcast packet compression (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                return;
+            }
+
+            Initialized = true;
+        }
+
+        ~BroadcastCompressionStream()
+        {
+            if (Initialized)
+                deflateEnd(&Stream);
+        }
+
+        z_stream Stream;
+        bool Initialized;
+    };
+}
+
+BroadcastPacket::BroadcastPacket(WorldPacket const& packet) : _packet(packet), _uncompressedAdler(0), _compressedAdler(0)
+{
+    if (_packet.size() > WorldSocket::MinSizeForCompression)
+        Compress();
+}
+
+void BroadcastPacket::Compress()
+{
+    thread_local BroadcastCompressionStream compression;
+    if (!compression.Initialized)
+        return;
+
+    z_stream* stream = &compression.Stream;
+    deflateReset(stream);
+
+    uint32 opcode = _packet.GetOpcode();
+    _compressedData.resize(deflateBound(stream, _packet.size() + sizeof(uint16)));
+
+    stream->next_out = _compressedData.data();
+    stream->avail_out = _compressedData.size();
+    stream->next_in = (Bytef*)&opcode;
+    stream->avail_in = sizeof(uint16);
+
+    int32 z_res = deflate(stream, Z_NO_FLUSH);
+    if (z_res == Z_OK)
+    {
+        stream->next_in = (Bytef*)_packet.contents();
+        stream->avail_in = _packet.size();
+        z_res = deflate(stream, Z_SYNC_FLUSH);
+    }
+
+    if (z_res != Z_OK)
+    {
+        TC_LOG_ERROR("network", "Can't compress broadcast packet (zlib: deflate) Error code: %i (%s, msg: %s)", z_res, zError(z_res), stream->msg);
+        _compressedData.clear();    // recipients compress it themselves
+        return;
+    }
+
+    _compressedData.resize(_compressedData.size() - stream->avail_out);
+    _uncompressedAdler = adler32(adler32(0x9827D8F1, (Bytef*)&opcode, 2), _packet.contents(), _packet.size());
+    _compressedAdler = adler32(1, _compressedData.data(), _compressedData.size());
+
+    WorldSocket::AddCompressedBytes(_packet.size() + sizeof(uint16));
+}
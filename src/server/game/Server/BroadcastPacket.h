@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BroadcastPacket_h__
+#define BroadcastPacket_h__
+
+#include "WorldPacket.h"
+#include <memory>
+#include <vector>
+
+/// Server packet sent unchanged to many sessions. The payload is stored and compressed once,
+/// every recipient socket shares the result and only encrypts its own header.
+class TC_GAME_API BroadcastPacket
+{
+public:
+    explicit BroadcastPacket(WorldPacket const& packet);
+
+    WorldPacket const& GetPacket() const { return _packet; }
+
+    /// Opcode and payload as a standalone raw deflate stream that does not reference any earlier data
+    bool IsCompressed() const { return !_compressedData.empty(); }
+    std::vector<uint8> const& GetCompressedData() const { return _compressedData; }
+    uint32 GetUncompressedAdler() const { return _uncompressedAdler; }
+    /// adler32 of the compressed data alone (starting at 1), to be combined with whatever the socket writes before it
+    uint32 GetCompressedAdler() const { return _compressedAdler; }
+
+private:
+    void Compress();
+
+    WorldPacket _packet;
+    std::vector<uint8> _compressedData;
+    uint32 _uncompressedAdler;
+    uint32 _compressedAdler;
+};
+
+typedef std::shared_ptr<BroadcastPacket const> BroadcastPacketPtr;
+
+#endif // BroadcastPacket_h__
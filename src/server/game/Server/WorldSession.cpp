@@ -57,6 +57,9 @@ namespace {
 
 std::string const DefaultPlayerName = "<none>";
 
+// set while a PROCESS_THREADSAFE_ASYNC handler runs on a network thread
+thread_local bool t_handlingAsyncPacket = false;
+
 } // namespace
 
 bool MapSessionFilter::Process(WorldPacket* packet)
@@ -64,7 +67,7 @@ bool MapSessionFilter::Process(WorldPacket* packet)
     ClientOpcodeHandler const* opHandle = opcodeTable[static_cast<OpcodeClient>(packet->GetOpcode())];
 
     //let's check if our opcode can be really processed in Map::Update()
-    if (opHandle->ProcessingPlace == PROCESS_INPLACE)
+    if (opHandle->ProcessingPlace == PROCESS_INPLACE || opHandle->ProcessingPlace == PROCESS_THREADSAFE_ASYNC)
         return true;
 
     //we do not process thread-unsafe packets
@@ -86,7 +89,7 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
     ClientOpcodeHandler const* opHandle = opcodeTable[static_cast<OpcodeClient>(packet->GetOpcode())];
 
     //check if packet handler is supposed to be safe
-    if (opHandle->ProcessingPlace == PROCESS_INPLACE)
+    if (opHandle->ProcessingPlace == PROCESS_INPLACE || opHandle->ProcessingPlace == PROCESS_THREADSAFE_ASYNC)
         return true;
 
     //thread-unsafe packets should be processed in World::UpdateSessions()
@@ -197,28 +200,32 @@ std::string WorldSession::GetPlayerInfo() const
     std::ostringstream ss;
 
     ss << "[Player: ";
-    if (!m_playerLoading.IsEmpty())
-        ss << "Logging in: " << m_playerLoading.ToString() << ", ";
-    else if (_player)
-        ss << _player->GetName() << ' ' << _player->GetGUID().ToString() << ", ";
+    // the player can change at any time while an async handler runs, only the account is safe to read there
+    if (!t_handlingAsyncPacket)
+    {
+        if (!m_playerLoading.IsEmpty())
+            ss << "Logging in: " << m_playerLoading.ToString() << ", ";
+        else if (_player)
+            ss << _player->GetName() << ' ' << _player->GetGUID().ToString() << ", ";
+    }
 
     ss << "Account: " << GetAccountId() << "]";
 
     return ss.str();
 }
 
-/// Send a packet to the client
-void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/)
+/// Validate a packet before sending it and select the connection it is sent on
+bool WorldSession::CanSendPacket(WorldPacket const* packet, bool forced, std::shared_ptr<WorldSocket>& socket) const
 {
     if (packet->GetOpcode() == NULL_OPCODE)
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of NULL_OPCODE to %s", GetPlayerInfo().c_str());
-        return;
+        return false;
     }
     else if (packet->GetOpcode() == UNKNOWN_OPCODE)
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of UNKNOWN_OPCODE to %s", GetPlayerInfo().c_str());
-        return;
+        return false;
     }
 
     ServerOpcodeHandler const* handler = opcodeTable[static_cast<OpcodeServer>(packet->GetOpcode())];
@@ -226,7 +233,7 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
     if (!handler)
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of opcode %u with non existing handler to %s", packet->GetOpcode(), GetPlayerInfo().c_str());
-        return;
+        return false;
     }
 
     // Default connection index defined in Opcodes.cpp table
@@ -238,16 +245,18 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
         if (packet->GetConnection() != CONNECTION_TYPE_INSTANCE && IsInstanceOnlyOpcode(packet->GetOpcode()))
         {
             TC_LOG_ERROR("network.opcode", "Prevented sending of instance only opcode %u with connection type %u to %s", packet->GetOpcode(), packet->GetConnection(), GetPlayerInfo().c_str());
-            return;
+            return false;
         }
 
         conIdx = packet->GetConnection();
     }
 
-    if (!m_Socket[conIdx])
+    // sockets are only replaced by the world thread, async handlers must not race with that
+    socket = t_handlingAsyncPacket ? std::atomic_load(&m_Socket[conIdx]) : m_Socket[conIdx];
+    if (!socket)
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of %s to non existent socket %u to %s", GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())).c_str(), conIdx, GetPlayerInfo().c_str());
-        return;
+        return false;
     }
 
     if (!forced)
@@ -255,7 +264,7 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
         if (handler->Status == STATUS_UNHANDLED)
         {
             TC_LOG_ERROR("network.opcode", "Prevented sending disabled opcode %s to %s", GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())).c_str(), GetPlayerInfo().c_str());
-            return;
+            return false;
         }
     }
 
@@ -293,10 +302,93 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
     }
 #endif                                                      // !TRINITY_DEBUG
 
-    sScriptMgr->OnPacketSend(this, *packet);
+    return true;
+}
+
+/// Send a packet to the client
+void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/)
+{
+    std::shared_ptr<WorldSocket> socket;
+    if (!CanSendPacket(packet, forced, socket))
+        return;
+
+    // scripts expect to run on the world thread and their registry is rebuilt there, replies of async handlers skip them
+    if (!t_handlingAsyncPacket)
+        sScriptMgr->OnPacketSend(this, *packet);
 
     TC_LOG_TRACE("network.opcode", "S->C: %s %s", GetPlayerInfo().c_str(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())).c_str());
-    m_Socket[conIdx]->SendPacket(*packet);
+    socket->SendPacket(*packet);
+}
+
+/// Send a packet to the client, taking over its storage instead of copying it
+void WorldSession::SendPacket(WorldPacket&& packet, bool forced /*= false*/)
+{
+    std::shared_ptr<WorldSocket> socket;
+    if (!CanSendPacket(&packet, forced, socket))
+        return;
+
+    if (!t_handlingAsyncPacket)
+        sScriptMgr->OnPacketSend(this, packet);
+
+    TC_LOG_TRACE("network.opcode", "S->C: %s %s", GetPlayerInfo().c_str(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet.GetOpcode())).c_str());
+    socket->SendPacket(std::move(packet));
+}
+
+/// Send a packet shared with other sessions, its compressed form is built only once
+void WorldSession::SendPacket(BroadcastPacketPtr const& packet, bool forced /*= false*/)
+{
+    std::shared_ptr<WorldSocket> socket;
+    if (!CanSendPacket(&packet->GetPacket(), forced, socket))
+        return;
+
+    if (!t_handlingAsyncPacket)
+        sScriptMgr->OnPacketSend(this, packet->GetPacket());
+
+    TC_LOG_TRACE("network.opcode", "S->C: %s %s", GetPlayerInfo().c_str(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetPacket().GetOpcode())).c_str());
+    socket->SendPacket(packet);
+}
+
+/// Handle a PROCESS_THREADSAFE_ASYNC packet on the network thread that received it
+/// Returns false if the packet has to go through the receive queue instead
+bool WorldSession::HandleAsyncPacket(WorldPacket& packet)
+{
+    ClientOpcodeHandler const* opHandle = opcodeTable[static_cast<OpcodeClient>(packet.GetOpcode())];
+    ASSERT(opHandle->ProcessingPlace == PROCESS_THREADSAFE_ASYNC);
+
+    // the player is owned by the world thread and cannot be checked here, so only opcodes that do not need one
+    // are handled async; STATUS_LOGGEDIN ones go through the receive queue, which checks for a logged in player
+    if (opHandle->Status != STATUS_AUTHED)
+        return false;
+
+    // prevent cheating with skip queue wait, the receive queue logs it
+    if (m_inQueue)
+        return false;
+
+    // flooding sessions are left to the world thread, it counts the packet and applies the configured policy
+    if (!AntiDOS.EvaluateAsyncOpcode(packet, time(NULL)))
+        return false;
+
+    t_handlingAsyncPacket = true;
+
+    try
+    {
+        // scripts expect to run on the world thread, neither OnPacketReceive nor OnPacketSend is called for async packets
+        opHandle->Call(this, packet);
+    }
+    catch (WorldPackets::PacketArrayMaxCapacityException const& pamce)
+    {
+        TC_LOG_ERROR("network", "PacketArrayMaxCapacityException: %s while parsing %s from %s.",
+            pamce.what(), GetOpcodeNameForLogging(static_cast<OpcodeClient>(packet.GetOpcode())).c_str(), GetPlayerInfo().c_str());
+    }
+    catch (ByteBufferException const&)
+    {
+        TC_LOG_ERROR("network", "WorldSession::HandleAsyncPacket ByteBufferException occured while parsing a packet (opcode: %u) from client %s, accountid=%i. Skipped packet.",
+            packet.GetOpcode(), GetRemoteAddress().c_str(), GetAccountId());
+        packet.hexlike();
+    }
+
+    t_handlingAsyncPacket = false;
+    return true;
 }
 
 /// Add an incoming packet to the queue
@@ -479,12 +571,12 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                 if (m_Socket[CONNECTION_TYPE_REALM])
                 {
                     m_Socket[CONNECTION_TYPE_REALM]->CloseSocket();
-                    m_Socket[CONNECTION_TYPE_REALM].reset();
+                    std::atomic_store(&m_Socket[CONNECTION_TYPE_REALM], std::shared_ptr<WorldSocket>());
                 }
                 if (m_Socket[CONNECTION_TYPE_INSTANCE])
                 {
                     m_Socket[CONNECTION_TYPE_INSTANCE]->CloseSocket();
-                    m_Socket[CONNECTION_TYPE_INSTANCE].reset();
+                    std::atomic_store(&m_Socket[CONNECTION_TYPE_INSTANCE], std::shared_ptr<WorldSocket>());
                 }
             }
         }
@@ -637,7 +729,7 @@ void WorldSession::LogoutPlayer(bool save)
     if (m_Socket[CONNECTION_TYPE_INSTANCE])
     {
         m_Socket[CONNECTION_TYPE_INSTANCE]->CloseSocket();
-        m_Socket[CONNECTION_TYPE_INSTANCE].reset();
+        std::atomic_store(&m_Socket[CONNECTION_TYPE_INSTANCE], std::shared_ptr<WorldSocket>());
     }
 
     m_playerLogout = false;
@@ -1110,28 +1202,49 @@ void WorldSession::InvalidateRBACData()
     _RBACData = NULL;
 }
 
-bool WorldSession::DosProtection::EvaluateOpcode(WorldPacket& p, time_t time) const
+bool WorldSession::DosProtection::CountPacket(uint16 opcode, time_t time, bool countOverLimit, uint32& amount) const
 {
-    uint32 maxPacketCounterAllowed = GetMaxPacketCounterAllowed(p.GetOpcode());
+    uint32 maxPacketCounterAllowed = GetMaxPacketCounterAllowed(opcode);
 
     // Return true if there no limit for the opcode
     if (!maxPacketCounterAllowed)
         return true;
 
-    PacketCounter& packetCounter = _PacketThrottlingMap[p.GetOpcode()];
+    // async packets are counted on network threads
+    std::lock_guard<std::mutex> lock(_packetThrottlingLock);
+
+    PacketCounter& packetCounter = _PacketThrottlingMap[opcode];
     if (packetCounter.lastReceiveTime != time)
     {
         packetCounter.lastReceiveTime = time;
         packetCounter.amountCounter = 0;
     }
 
+    amount = packetCounter.amountCounter + 1;
+    if (amount > maxPacketCounterAllowed && !countOverLimit)
+        return false;
+
     // Check if player is flooding some packets
-    if (++packetCounter.amountCounter <= maxPacketCounterAllowed)
+    packetCounter.amountCounter = amount;
+    return amount <= maxPacketCounterAllowed;
+}
+
+bool WorldSession::DosProtection::EvaluateAsyncOpcode(WorldPacket const& p, time_t time) const
+{
+    // a packet over the limit is not counted here, EvaluateOpcode counts it once it reaches the receive queue
+    uint32 amount;
+    return CountPacket(p.GetOpcode(), time, false, amount);
+}
+
+bool WorldSession::DosProtection::EvaluateOpcode(WorldPacket& p, time_t time) const
+{
+    uint32 amount;
+    if (CountPacket(p.GetOpcode(), time, true, amount))
         return true;
 
     TC_LOG_WARN("network", "AntiDOS: Account %u, IP: %s, Ping: %u, Character: %s, flooding packet (opc: %s (0x%X), count: %u)",
         Session->GetAccountId(), Session->GetRemoteAddress().c_str(), Session->GetLatency(), Session->GetPlayerName().c_str(),
-        opcodeTable[static_cast<OpcodeClient>(p.GetOpcode())]->Name, p.GetOpcode(), packetCounter.amountCounter);
+        opcodeTable[static_cast<OpcodeClient>(p.GetOpcode())]->Name, p.GetOpcode(), amount);
 
     switch (_policy)
     {
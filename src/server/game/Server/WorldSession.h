@@ -24,6 +24,7 @@
 #define __WORLDSESSION_H
 
 #include "Common.h"
+#include "BroadcastPacket.h"
 #include "DatabaseEnvFwd.h"
 #include "LockedQueue.h"
 #include "ObjectGuid.h"
@@ -31,6 +32,8 @@
 #include "QueryCallbackProcessor.h"
 #include "SharedDefines.h"
 #include <array>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -965,7 +968,10 @@ class TC_GAME_API WorldSession
         bool IsAddonRegistered(const std::string& prefix) const;
 
         void SendPacket(WorldPacket const* packet, bool forced = false);
-        void AddInstanceConnection(std::shared_ptr<WorldSocket> sock) { m_Socket[CONNECTION_TYPE_INSTANCE] = sock; }
+        void SendPacket(WorldPacket&& packet, bool forced = false);
+        void SendPacket(BroadcastPacketPtr const& packet, bool forced = false);
+        bool HandleAsyncPacket(WorldPacket& packet);
+        void AddInstanceConnection(std::shared_ptr<WorldSocket> sock) { std::atomic_store(&m_Socket[CONNECTION_TYPE_INSTANCE], sock); }
 
         void SendNotification(char const* format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(uint32 stringId, ...);
@@ -1856,6 +1862,7 @@ class TC_GAME_API WorldSession
         void LoadRecoveries();
     private:
         void ProcessQueryCallbacks();
+        bool CanSendPacket(WorldPacket const* packet, bool forced, std::shared_ptr<WorldSocket>& socket) const;
 
         QueryResultHolderFuture _realmAccountLoginCallback;
         QueryResultHolderFuture _accountLoginCallback;
@@ -1871,6 +1878,8 @@ class TC_GAME_API WorldSession
             public:
                 DosProtection(WorldSession* s);
                 bool EvaluateOpcode(WorldPacket& p, time_t time) const;
+                /// Counts a packet handled outside of the world thread, false (without counting it) if the flood policy has to be applied by EvaluateOpcode
+                bool EvaluateAsyncOpcode(WorldPacket const& p, time_t time) const;
             protected:
                 enum Policy
                 {
@@ -1880,6 +1889,7 @@ class TC_GAME_API WorldSession
                 };
 
                 uint32 GetMaxPacketCounterAllowed(uint16 opcode) const;
+                bool CountPacket(uint16 opcode, time_t time, bool countOverLimit, uint32& amount) const;
 
                 WorldSession* Session;
 
@@ -1888,6 +1898,7 @@ class TC_GAME_API WorldSession
                 typedef std::unordered_map<uint16, PacketCounter> PacketThrottlingMap;
                 // mark this member as "mutable" so it can be modified even in const functions
                 mutable PacketThrottlingMap _PacketThrottlingMap;
+                mutable std::mutex _packetThrottlingLock;
 
                 DosProtection(DosProtection const& right) = delete;
                 DosProtection& operator=(DosProtection const& right) = delete;
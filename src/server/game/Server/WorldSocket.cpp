@@ -50,13 +50,26 @@ class EncryptablePacket : public WorldPacket
 {
 public:
     EncryptablePacket(WorldPacket const& packet, bool encrypt) : WorldPacket(packet), _encrypt(encrypt) { }
+    EncryptablePacket(WorldPacket&& packet, bool encrypt) : WorldPacket(std::move(packet)), _encrypt(encrypt) { }
+    EncryptablePacket(BroadcastPacketPtr const& packet, bool encrypt) : WorldPacket(), _encrypt(encrypt), _broadcast(packet) { }
 
     bool NeedsEncryption() const { return _encrypt; }
 
+    /// Packet contents, either owned or shared with other sockets
+    WorldPacket const& GetPayload() const { return _broadcast ? _broadcast->GetPacket() : *this; }
+    BroadcastPacket const* GetBroadcast() const { return _broadcast.get(); }
+
 private:
     bool _encrypt;
+    BroadcastPacketPtr _broadcast;
 };
 
+namespace
+{
+    std::atomic<uint64> CompressedBytes(0);
+    std::atomic<uint64> CompressedPacketBytesSent(0);
+}
+
 using boost::asio::ip::tcp;
 
 std::string const WorldSocket::ServerConnectionInitialize("WORLD OF WARCRAFT CONNECTION - SERVER TO CLIENT");
@@ -65,6 +78,18 @@ uint32 const WorldSocket::MinSizeForCompression = 0x400;
 
 uint32 const SizeOfClientHeader = sizeof(uint32) + sizeof(uint16);
 uint32 const SizeOfServerHeader = sizeof(uint32) + sizeof(uint16);
+uint32 const MaxCompressionFlushSize = 16;  // empty stored block written by FlushCompressionHistory, with slack
+
+void WorldSocket::AddCompressedBytes(uint64 bytes)
+{
+    CompressedBytes += bytes;
+}
+
+void WorldSocket::ConsumeCompressionStatistics(uint64& bytesCompressed, uint64& bytesSent)
+{
+    bytesCompressed = CompressedBytes.exchange(0);
+    bytesSent = CompressedPacketBytesSent.exchange(0);
+}
 
 uint8 const WorldSocket::AuthCheckSeed[16] = { 0xC5, 0xC6, 0x98, 0x95, 0x76, 0x3F, 0x1D, 0xCD, 0xB6, 0xA1, 0x37, 0x28, 0xB3, 0x12, 0xFF, 0x8A };
 uint8 const WorldSocket::SessionKeySeed[16] = { 0x58, 0xCB, 0xCF, 0x40, 0xFE, 0x2E, 0xCE, 0xA6, 0x5A, 0x90, 0xB8, 0x01, 0x68, 0x6C, 0x28, 0x0B };
@@ -76,7 +101,8 @@ uint8 const ClientTypeSeed_Mc64[16] = { 0x34, 0x1C, 0xFE, 0xFE, 0x3D, 0x72, 0xAC
 
 WorldSocket::WorldSocket(tcp::socket&& socket) : Socket(std::move(socket)),
     _type(CONNECTION_TYPE_REALM), _key(0), _OverSpeedPings(0),
-    _worldSession(nullptr), _authed(false), _sendBufferSize(4096), _compressionStream(nullptr)
+    _worldSession(nullptr), _authed(false), _sendBufferSize(4096), _compressionStream(nullptr),
+    _compressionHasHistory(false)
 {
     _serverChallenge.SetRand(8 * 16);
     _headerBuffer.Resize(SizeOfClientHeader);
@@ -211,9 +237,15 @@ bool WorldSocket::Update()
     MessageBuffer buffer(_sendBufferSize);
     while (_bufferQueue.Dequeue(queued))
     {
-        uint32 packetSize = queued->size();
+        uint32 packetSize = queued->GetPayload().size();
         if (packetSize > MinSizeForCompression && queued->NeedsEncryption())
-            packetSize = compressBound(packetSize) + sizeof(CompressedWorldPacket);
+        {
+            // room for compressing it ourselves too, in case the shared copy can not be used
+            if (queued->GetBroadcast() && queued->GetBroadcast()->IsCompressed())
+                packetSize = std::max<uint32>(queued->GetBroadcast()->GetCompressedData().size(), compressBound(packetSize)) + MaxCompressionFlushSize + sizeof(CompressedWorldPacket);
+            else
+                packetSize = compressBound(packetSize) + sizeof(CompressedWorldPacket);
+        }
 
         if (buffer.GetRemainingSpace() < packetSize + SizeOfServerHeader)
         {
@@ -462,7 +494,7 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
                 return ReadDataHandlerResult::Error;
             }
 
-            OpcodeHandler const* handler = opcodeTable[opcode];
+            ClientOpcodeHandler const* handler = opcodeTable[opcode];
             if (!handler)
             {
                 TC_LOG_ERROR("network.opcode", "No defined handler for opcode %s sent by %s", GetOpcodeNameForLogging(static_cast<OpcodeClient>(packet.GetOpcode())).c_str(), _worldSession->GetPlayerInfo().c_str());
@@ -473,6 +505,10 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
             // Catches people idling on the login screen and any lingering ingame connections.
             _worldSession->ResetTimeOutTime();
 
+            // Static data queries are answered right away, without waiting for the next world update
+            if (handler->ProcessingPlace == PROCESS_THREADSAFE_ASYNC && _worldSession->HandleAsyncPacket(packet))
+                break;
+
             // Copy the packet to the heap before enqueuing
             _worldSession->QueuePacket(new WorldPacket(std::move(packet)));
             break;
@@ -512,8 +548,33 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
 }
 
-void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBuffer& buffer)
+void WorldSocket::SendPacket(WorldPacket&& packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (sPacketLog->CanLogPacket())
+        sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType());
+
+    // takes over the packet storage, the contents are copied only once - into the send buffer
+    _bufferQueue.Enqueue(new EncryptablePacket(std::move(packet), _authCrypt.IsInitialized()));
+}
+
+void WorldSocket::SendPacket(BroadcastPacketPtr const& packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (sPacketLog->CanLogPacket())
+        sPacketLog->LogPacket(packet->GetPacket(), SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType());
+
+    _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
+}
+
+void WorldSocket::WritePacketToBuffer(EncryptablePacket const& encryptablePacket, MessageBuffer& buffer)
 {
+    WorldPacket const& packet = encryptablePacket.GetPayload();
+    BroadcastPacket const* broadcast = encryptablePacket.GetBroadcast();
     uint32 opcode = packet.GetOpcode();
     uint32 packetSize = packet.size();
 
@@ -521,23 +582,46 @@ void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBu
     uint8* headerPos = buffer.GetWritePointer();
     buffer.WriteCompleted(SizeOfServerHeader);
 
-    if (packetSize > MinSizeForCompression && packet.NeedsEncryption())
+    if (packetSize > MinSizeForCompression && encryptablePacket.NeedsEncryption())
     {
         CompressedWorldPacket cmp;
         cmp.UncompressedSize = packetSize + 2;
-        cmp.UncompressedAdler = adler32(adler32(0x9827D8F1, (Bytef*)&opcode, 2), packet.contents(), packetSize);
 
         // Reserve space for compression info - uncompressed size and checksums
         uint8* compressionInfo = buffer.GetWritePointer();
         buffer.WriteCompleted(sizeof(CompressedWorldPacket));
 
-        uint32 compressedSize = CompressPacket(buffer.GetWritePointer(), packet);
+        // the shared data was compressed without our history, make sure the client can not be pointed into it later
+        uint32 flushSize = 0;
+        bool flushed = !broadcast || !broadcast->IsCompressed() || FlushCompressionHistory(buffer.GetWritePointer(), flushSize);
+        uint8* compressedStart = buffer.GetWritePointer();
+        buffer.WriteCompleted(flushSize);
+
+        if (broadcast && broadcast->IsCompressed() && flushed)
+        {
+            cmp.UncompressedAdler = broadcast->GetUncompressedAdler();
+            cmp.CompressedAdler = adler32(0x9827D8F1, compressedStart, flushSize);
+
+            std::vector<uint8> const& compressedData = broadcast->GetCompressedData();
+            buffer.Write(compressedData.data(), compressedData.size());
+            cmp.CompressedAdler = adler32_combine(cmp.CompressedAdler, broadcast->GetCompressedAdler(), compressedData.size());
+            packetSize = flushSize + compressedData.size() + sizeof(CompressedWorldPacket);
+        }
+        else
+        {
+            // whatever a failed flush produced is still part of our stream, send it in front of our own compressed copy
+            cmp.UncompressedAdler = adler32(adler32(0x9827D8F1, (Bytef*)&opcode, 2), packet.contents(), packetSize);
 
-        cmp.CompressedAdler = adler32(0x9827D8F1, buffer.GetWritePointer(), compressedSize);
+            uint32 compressedSize = CompressPacket(buffer.GetWritePointer(), packet);
+            buffer.WriteCompleted(compressedSize);
+
+            cmp.CompressedAdler = adler32(0x9827D8F1, compressedStart, flushSize + compressedSize);
+            packetSize = flushSize + compressedSize + sizeof(CompressedWorldPacket);
+            CompressedBytes += cmp.UncompressedSize;
+        }
 
         memcpy(compressionInfo, &cmp, sizeof(CompressedWorldPacket));
-        buffer.WriteCompleted(compressedSize);
-        packetSize = compressedSize + sizeof(CompressedWorldPacket);
+        CompressedPacketBytesSent += cmp.UncompressedSize;
 
         opcode = SMSG_COMPRESSED_PACKET;
     }
@@ -581,9 +665,38 @@ uint32 WorldSocket::CompressPacket(uint8* buffer, WorldPacket const& packet)
         return 0;
     }
 
+    _compressionHasHistory = true;
     return bufferSize - _compressionStream->avail_out;
 }
 
+bool WorldSocket::FlushCompressionHistory(uint8* buffer, uint32& flushSize)
+{
+    flushSize = 0;
+    if (!_compressionHasHistory)
+        return true;
+
+    // full flush makes the next compressed packet independent from everything compressed so far
+    _compressionStream->next_out = buffer;
+    _compressionStream->avail_out = MaxCompressionFlushSize;
+    _compressionStream->next_in = nullptr;
+    _compressionStream->avail_in = 0;
+
+    int32 z_res = deflate(_compressionStream, Z_FULL_FLUSH);
+    flushSize = MaxCompressionFlushSize - _compressionStream->avail_out;
+    if (z_res != Z_OK)
+    {
+        TC_LOG_ERROR("network", "Can't flush packet compression (zlib: deflate) Error code: %i (%s, msg: %s)", z_res, zError(z_res), _compressionStream->msg);
+        return false;
+    }
+
+    // out of space, the flush may be incomplete
+    if (!_compressionStream->avail_out)
+        return false;
+
+    _compressionHasHistory = false;
+    return true;
+}
+
 struct AccountInfo
 {
     struct
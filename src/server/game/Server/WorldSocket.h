@@ -21,6 +21,7 @@
 
 #include "Common.h"
 #include "BigNumber.h"
+#include "BroadcastPacket.h"
 #include "DatabaseEnvFwd.h"
 #include "MessageBuffer.h"
 #include "QueryCallbackProcessor.h"
@@ -67,7 +68,6 @@ class TC_GAME_API WorldSocket : public Socket<WorldSocket>
 {
     static std::string const ServerConnectionInitialize;
     static std::string const ClientConnectionInitialize;
-    static uint32 const MinSizeForCompression;
 
     static uint8 const AuthCheckSeed[16];
     static uint8 const SessionKeySeed[16];
@@ -76,6 +76,12 @@ class TC_GAME_API WorldSocket : public Socket<WorldSocket>
     typedef Socket<WorldSocket> BaseSocket;
 
 public:
+    static uint32 const MinSizeForCompression;
+
+    /// Packet compression statistics - bytes passed through deflate and uncompressed bytes of all compressed packets written to sockets
+    static void AddCompressedBytes(uint64 bytes);
+    static void ConsumeCompressionStatistics(uint64& bytesCompressed, uint64& bytesSent);
+
     WorldSocket(boost::asio::ip::tcp::socket&& socket);
     ~WorldSocket();
 
@@ -86,6 +92,8 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    void SendPacket(WorldPacket&& packet);
+    void SendPacket(BroadcastPacketPtr const& packet);
 
     ConnectionType GetConnectionType() const { return _type; }
 
@@ -117,6 +125,8 @@ private:
     void SendPacketAndLogOpcode(WorldPacket const& packet);
     void WritePacketToBuffer(EncryptablePacket const& packet, MessageBuffer& buffer);
     uint32 CompressPacket(uint8* buffer, WorldPacket const& packet);
+    /// false if the history could not be dropped, flushSize bytes were written to buffer either way
+    bool FlushCompressionHistory(uint8* buffer, uint32& flushSize);
 
     void HandleSendAuthSession();
     void HandleAuthSession(std::shared_ptr<WorldPackets::Auth::AuthSession> authSession);
@@ -150,6 +160,7 @@ private:
     std::size_t _sendBufferSize;
 
     z_stream* _compressionStream;
+    bool _compressionHasHistory;
 
     QueryCallbackProcessor _queryProcessor;
     std::string _ipCountry;
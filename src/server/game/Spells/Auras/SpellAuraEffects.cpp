@@ -601,6 +601,20 @@ void AuraEffect::GetApplicationList(std::list<AuraApplication*> & applicationLis
     }
 }
 
+void AuraEffect::SetAmount(int32 amount)
+{
+    m_amount = amount;
+    m_canBeRecalculated = false;
+    InvalidateTargetAuraModifierCache();
+}
+
+void AuraEffect::InvalidateTargetAuraModifierCache() const
+{
+    for (auto const& pair : GetBase()->GetApplicationMap())
+        if (pair.second->HasEffect(GetEffIndex()))
+            pair.second->GetTarget()->InvalidateAuraModifierCache(GetAuraType());
+}
+
 int32 AuraEffect::CalculateAmount(Unit* caster)
 {
     // default amount calculation
@@ -828,7 +842,10 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
     if (handleMask & AURA_EFFECT_HANDLE_CHANGE_AMOUNT)
     {
         if (!mark)
+        {
             m_amount = newAmount;
+            InvalidateTargetAuraModifierCache();
+        }
         else
             SetAmount(newAmount);
         CalculateSpellMod();
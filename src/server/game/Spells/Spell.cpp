@@ -1347,10 +1347,14 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
         if (uint32 maxTargets = m_spellValue->MaxAffectedTargets)
             Trinity::Containers::RandomResize(targets, maxTargets);
 
+        // line of sight to the area center, checked for all targets at once instead of per target and effect
+        if (!IsLOSIgnored())
+            m_caster->RemoveUnitsOutOfLOS(targets, *center);
+
         for (std::list<WorldObject*>::iterator itr = targets.begin(); itr != targets.end(); ++itr)
         {
             if (Unit* unit = (*itr)->ToUnit())
-                AddUnitTarget(unit, effMask, false, true, center);
+                AddUnitTarget(unit, effMask, false, true, false);
             else if (GameObject* gObjTarget = (*itr)->ToGameObject())
                 AddGOTarget(gObjTarget, effMask);
         }
@@ -2244,11 +2248,11 @@ class ProcReflectDelayed : public BasicEvent
         ObjectGuid _casterGuid;
 };
 
-void Spell::AddUnitTarget(Unit* target, uint32 effectMask, bool checkIfValid /*= true*/, bool implicit /*= true*/, Position const* losPosition /*= nullptr*/)
+void Spell::AddUnitTarget(Unit* target, uint32 effectMask, bool checkIfValid /*= true*/, bool implicit /*= true*/, bool checkLOS /*= true*/)
 {
     uint32 validEffectMask = 0;
     for (SpellEffectInfo const* effect : GetEffects())
-        if (effect && (effectMask & (1 << effect->EffectIndex)) != 0 && CheckEffectTarget(target, effect, losPosition))
+        if (effect && (effectMask & (1 << effect->EffectIndex)) != 0 && CheckEffectTarget(target, effect, checkLOS))
             validEffectMask |= 1 << effect->EffectIndex;
 
     effectMask &= validEffectMask;
@@ -7201,7 +7205,7 @@ CurrentSpellTypes Spell::GetCurrentContainer() const
     return CURRENT_GENERIC_SPELL;
 }
 
-bool Spell::CheckEffectTarget(Unit const* target, SpellEffectInfo const* effect, Position const* losPosition) const
+bool Spell::CheckEffectTarget(Unit const* target, SpellEffectInfo const* effect, bool checkLOS) const
 {
     if (!effect->IsEffect())
         return false;
@@ -7226,6 +7230,26 @@ bool Spell::CheckEffectTarget(Unit const* target, SpellEffectInfo const* effect,
             break;
     }
 
+    // area targets are checked against the area center all at once by SelectImplicitAreaTargets
+    if (!checkLOS || IsLOSIgnored())
+        return true;
+
+    /// @todo shit below shouldn't be here, but it's temporary
+    //Check targets for LOS visibility
+    // Get GO cast coordinates if original caster -> GO
+    WorldObject* caster = NULL;
+    if (m_originalCasterGUID.IsGameObject())
+        caster = m_caster->GetMap()->GetGameObject(m_originalCasterGUID);
+    if (!caster)
+        caster = m_caster;
+    if (target != m_caster && !target->IsWithinLOSInMap(caster))
+        return false;
+
+    return true;
+}
+
+bool Spell::IsLOSIgnored() const
+{
     // check for ignore LOS on the effect itself
     if (m_spellInfo->HasAttribute(SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS) || DisableMgr::IsDisabledFor(DISABLE_TYPE_SPELL, m_spellInfo->Id, NULL, SPELL_DISABLE_LOS))
         return true;
@@ -7234,23 +7258,7 @@ bool Spell::CheckEffectTarget(Unit const* target, SpellEffectInfo const* effect,
     if (IsTriggered() && m_triggeredByAuraSpell && (m_triggeredByAuraSpell->HasAttribute(SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS) || DisableMgr::IsDisabledFor(DISABLE_TYPE_SPELL, m_triggeredByAuraSpell->Id, NULL, SPELL_DISABLE_LOS)))
         return true;
 
-    /// @todo shit below shouldn't be here, but it's temporary
-    //Check targets for LOS visibility
-    if (losPosition)
-        return target->IsWithinLOS(losPosition->GetPositionX(), losPosition->GetPositionY(), losPosition->GetPositionZ());
-    else
-    {
-        // Get GO cast coordinates if original caster -> GO
-        WorldObject* caster = NULL;
-        if (m_originalCasterGUID.IsGameObject())
-            caster = m_caster->GetMap()->GetGameObject(m_originalCasterGUID);
-        if (!caster)
-            caster = m_caster;
-        if (target != m_caster && !target->IsWithinLOSInMap(caster))
-            return false;
-    }
-
-    return true;
+    return false;
 }
 
 bool Spell::CheckEffectTarget(GameObject const* target, SpellEffectInfo const* effect) const
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CharacterInfoStore.h"
+#include "Errors.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    // player low guids start at 1 and never reach the 40 bit counter limit
+    ObjectGuid::LowType const EmptyKey = 0;
+    ObjectGuid::LowType const ErasedKey = UI64LIT(0xFFFFFFFFFFFFFFFF);
+
+    std::size_t const MinCapacity = 64;
+    std::size_t const NameBlockSize = 64 * 1024;
+}
+
+CharacterInfoStore::CharacterInfoStore() : _size(0), _erased(0), _nameBlockBytes(0), _usedInLastNameBlock(0), _unusedNameBytes(0)
+{
+}
+
+std::size_t CharacterInfoStore::Hash(ObjectGuid::LowType guid)
+{
+    // guids are mostly sequential, mix them so neighbours do not end up in one probe run
+    guid ^= guid >> 33;
+    guid *= UI64LIT(0xFF51AFD7ED558CCD);
+    guid ^= guid >> 33;
+    return std::size_t(guid);
+}
+
+std::size_t CharacterInfoStore::FindSlot(ObjectGuid::LowType guid) const
+{
+    if (_slots.empty() || guid == EmptyKey || guid == ErasedKey)
+        return _slots.size();
+
+    std::size_t mask = _slots.size() - 1;
+    for (std::size_t i = Hash(guid) & mask; ; i = (i + 1) & mask)
+    {
+        if (_slots[i].Key == guid)
+            return i;
+
+        if (_slots[i].Key == EmptyKey)
+            return _slots.size();
+    }
+}
+
+CharacterInfo const* CharacterInfoStore::Find(ObjectGuid::LowType guid) const
+{
+    std::size_t slot = FindSlot(guid);
+    return slot != _slots.size() ? &_slots[slot].Info : nullptr;
+}
+
+CharacterInfo* CharacterInfoStore::Find(ObjectGuid::LowType guid)
+{
+    std::size_t slot = FindSlot(guid);
+    return slot != _slots.size() ? &_slots[slot].Info : nullptr;
+}
+
+CharacterInfo& CharacterInfoStore::Insert(ObjectGuid::LowType guid)
+{
+    ASSERT(guid != EmptyKey && guid != ErasedKey);
+
+    if (CharacterInfo* info = Find(guid))
+        return *info;
+
+    // keep at most 3/4 of the slots taken, erased slots count as taken until the next rehash
+    if ((_size + _erased + 1) * 4 > _slots.size() * 3)
+        Rehash(std::max(MinCapacity, (_size + 1) * 4 / 3 * 2));
+
+    std::size_t mask = _slots.size() - 1;
+    std::size_t i = Hash(guid) & mask;
+    while (_slots[i].Key != EmptyKey && _slots[i].Key != ErasedKey)
+        i = (i + 1) & mask;
+
+    if (_slots[i].Key == ErasedKey)
+        --_erased;
+
+    ++_size;
+    _slots[i].Key = guid;
+    _slots[i].Info = { "", 0, 0, 0, 0, 0, false };
+    return _slots[i].Info;
+}
+
+bool CharacterInfoStore::Erase(ObjectGuid::LowType guid)
+{
+    std::size_t slot = FindSlot(guid);
+    if (slot == _slots.size())
+        return false;
+
+    // the empty name is not stored in the blocks
+    if (*_slots[slot].Info.Name)
+        _unusedNameBytes += strlen(_slots[slot].Info.Name) + 1;
+
+    _slots[slot].Key = ErasedKey;
+    --_size;
+    ++_erased;
+    return true;
+}
+
+void CharacterInfoStore::SetName(CharacterInfo& info, std::string const& name)
+{
+    if (!strcmp(info.Name, name.c_str()))
+        return;
+
+    if (*info.Name)
+        _unusedNameBytes += strlen(info.Name) + 1;
+
+    info.Name = StoreName(name.c_str(), name.length());
+}
+
+char const* CharacterInfoStore::StoreName(char const* name, std::size_t nameLength)
+{
+    if (!nameLength)
+        return "";
+
+    std::size_t length = nameLength + 1;
+    if (_nameBlocks.empty() || _usedInLastNameBlock + length > NameBlockSize)
+    {
+        std::size_t blockSize = std::max(length, NameBlockSize);
+        _nameBlocks.emplace_back(new char[blockSize]);
+        _nameBlockBytes += blockSize;
+        _usedInLastNameBlock = 0;
+    }
+
+    char* stored = _nameBlocks.back().get() + _usedInLastNameBlock;
+    memcpy(stored, name, length);
+    _usedInLastNameBlock += length;
+    return stored;
+}
+
+bool CharacterInfoStore::CompactNames()
+{
+    // at least one whole block and a quarter of all name bytes have to be reclaimable
+    if (_unusedNameBytes < NameBlockSize || _unusedNameBytes * 4 < _nameBlockBytes)
+        return false;
+
+    std::vector<std::unique_ptr<char[]>> oldNameBlocks;
+    oldNameBlocks.swap(_nameBlocks);
+    _nameBlockBytes = 0;
+    _usedInLastNameBlock = 0;
+    _unusedNameBytes = 0;
+
+    for (Slot& slot : _slots)
+        if (slot.Key != EmptyKey && slot.Key != ErasedKey)
+            slot.Info.Name = StoreName(slot.Info.Name, strlen(slot.Info.Name));
+
+    return true;
+}
+
+void CharacterInfoStore::Reserve(std::size_t count)
+{
+    std::size_t capacity = MinCapacity;
+    while (capacity * 3 < count * 4)
+        capacity *= 2;
+
+    if (capacity > _slots.size())
+        Rehash(capacity);
+}
+
+void CharacterInfoStore::Rehash(std::size_t capacity)
+{
+    std::size_t powerOfTwo = MinCapacity;
+    while (powerOfTwo < capacity)
+        powerOfTwo *= 2;
+
+    std::vector<Slot> oldSlots(powerOfTwo);
+    oldSlots.swap(_slots);
+    for (Slot& slot : _slots)
+        slot.Key = EmptyKey;
+
+    std::size_t mask = _slots.size() - 1;
+    for (Slot const& slot : oldSlots)
+    {
+        if (slot.Key == EmptyKey || slot.Key == ErasedKey)
+            continue;
+
+        std::size_t i = Hash(slot.Key) & mask;
+        while (_slots[i].Key != EmptyKey)
+            i = (i + 1) & mask;
+
+        _slots[i] = slot;
+    }
+
+    _erased = 0;
+}
+
+void CharacterInfoStore::Clear()
+{
+    std::vector<Slot>().swap(_slots);
+    _size = 0;
+    _erased = 0;
+
+    _nameBlocks.clear();
+    _nameBlockBytes = 0;
+    _usedInLastNameBlock = 0;
+    _unusedNameBytes = 0;
+}
+
+std::size_t CharacterInfoStore::GetMemoryUsage() const
+{
+    return _slots.capacity() * sizeof(Slot) + _nameBlockBytes + _nameBlocks.capacity() * sizeof(std::unique_ptr<char[]>);
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CharacterInfoStore_h__
+#define CharacterInfoStore_h__
+
+#include "Define.h"
+#include "ObjectGuid.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+struct CharacterInfo
+{
+    char const* Name;   ///< owned by the store, stays valid after a rename until the store is cleared or its names are compacted
+    uint32 AccountId;
+    uint8 Class;
+    uint8 Race;
+    uint8 Sex;
+    uint8 Level;
+    bool IsDeleted;
+};
+
+/// CharacterInfo of every character keyed by the low guid, held in a single open addressing table
+/// with the names packed into shared blocks instead of one heap allocation each.
+/// Inserting may move the entries, do not keep CharacterInfo pointers across an Insert.
+class TC_GAME_API CharacterInfoStore
+{
+public:
+    CharacterInfoStore();
+
+    CharacterInfo const* Find(ObjectGuid::LowType guid) const;
+    CharacterInfo* Find(ObjectGuid::LowType guid);
+
+    /// Returns the existing entry for guid or a new zeroed one
+    CharacterInfo& Insert(ObjectGuid::LowType guid);
+    bool Erase(ObjectGuid::LowType guid);
+    void SetName(CharacterInfo& info, std::string const& name);
+
+    /// Repacks the names into new blocks when enough of the old ones is taken by replaced or erased names,
+    /// every CharacterInfo::Name pointer held outside of the store is invalid afterwards. Returns true if it did.
+    bool CompactNames();
+
+    void Reserve(std::size_t count);
+    void Clear();
+
+    std::size_t GetSize() const { return _size; }
+    /// Bytes held by the table and the name blocks
+    std::size_t GetMemoryUsage() const;
+    /// Bytes of the name blocks taken by names that were replaced or erased
+    std::size_t GetUnusedNameBytes() const { return _unusedNameBytes; }
+
+private:
+    struct Slot
+    {
+        ObjectGuid::LowType Key;
+        CharacterInfo Info;
+    };
+
+    static std::size_t Hash(ObjectGuid::LowType guid);
+    std::size_t FindSlot(ObjectGuid::LowType guid) const;
+    void Rehash(std::size_t capacity);
+    char const* StoreName(char const* name, std::size_t nameLength);
+
+    std::vector<Slot> _slots;
+    std::size_t _size;
+    std::size_t _erased;
+
+    std::vector<std::unique_ptr<char[]>> _nameBlocks;
+    std::size_t _nameBlockBytes;
+    std::size_t _usedInLastNameBlock;
+    std::size_t _unusedNameBytes;
+};
+
+#endif // CharacterInfoStore_h__
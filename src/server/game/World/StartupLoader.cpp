@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StartupLoader.h"
+#include "Errors.h"
+#include "Log.h"
+#include "Timer.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+    // how many of the slowest loaders are named in the summary
+    std::size_t const REPORTED_SLOWEST_LOADERS = 5;
+}
+
+void StartupLoader::Add(std::string const& name, std::function<void()>&& loader, std::vector<std::string> const& dependencies /*= {}*/)
+{
+    std::size_t index = _loaders.size();
+    _loaders.push_back({ name, std::move(loader), {}, uint32(dependencies.size()), 0 });
+
+    for (std::string const& dependency : dependencies)
+    {
+        auto itr = std::find_if(_loaders.begin(), _loaders.begin() + index, [&dependency](Loader const& added) { return added.Name == dependency; });
+        ASSERT(itr != _loaders.begin() + index, "%s: loader %s depends on %s which was not added before it", _name.c_str(), name.c_str(), dependency.c_str());
+        itr->Dependents.push_back(index);
+    }
+}
+
+void StartupLoader::Run(uint32 threadCount)
+{
+    uint32 oldMSTime = getMSTime();
+
+    threadCount = std::max<uint32>(std::min<uint32>(threadCount, uint32(_loaders.size())), 1);
+    if (threadCount == 1)
+    {
+        for (Loader& loader : _loaders)
+            RunLoader(loader);
+    }
+    else
+    {
+        std::mutex lock;
+        std::condition_variable condition;
+        std::deque<std::size_t> ready;
+        std::vector<uint32> pendingDependencies(_loaders.size());
+        std::size_t remaining = _loaders.size();
+
+        for (std::size_t i = 0; i < _loaders.size(); ++i)
+        {
+            pendingDependencies[i] = _loaders[i].DependencyCount;
+            if (!pendingDependencies[i])
+                ready.push_back(i);
+        }
+
+        auto worker = [&]()
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            while (true)
+            {
+                condition.wait(guard, [&]() { return !ready.empty() || !remaining; });
+                if (!remaining)
+                    return;
+
+                std::size_t index = ready.front();
+                ready.pop_front();
+
+                guard.unlock();
+                RunLoader(_loaders[index]);
+                guard.lock();
+
+                --remaining;
+                for (std::size_t dependent : _loaders[index].Dependents)
+                    if (!--pendingDependencies[dependent])
+                        ready.push_back(dependent);
+
+                condition.notify_all();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (uint32 i = 1; i < threadCount; ++i)
+            threads.emplace_back(worker);
+
+        worker();
+
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    uint32 totalDuration = 0;
+    std::vector<Loader const*> slowest;
+    for (Loader const& loader : _loaders)
+    {
+        totalDuration += loader.Duration;
+        slowest.push_back(&loader);
+    }
+
+    std::size_t reported = std::min(slowest.size(), REPORTED_SLOWEST_LOADERS);
+    std::partial_sort(slowest.begin(), slowest.begin() + reported, slowest.end(), [](Loader const* left, Loader const* right) { return left->Duration > right->Duration; });
+
+    std::ostringstream slowestNames;
+    for (std::size_t i = 0; i < reported; ++i)
+        slowestNames << (i ? ", " : "") << slowest[i]->Name << " (" << slowest[i]->Duration << " ms)";
+
+    TC_LOG_INFO("server.loading", ">> %s: " SZFMTD " loaders finished in %u ms on %u thread(s), %u ms of loading in total, slowest: %s",
+        _name.c_str(), _loaders.size(), GetMSTimeDiffToNow(oldMSTime), threadCount, totalDuration, slowestNames.str().c_str());
+}
+
+uint32 StartupLoader::GetThreadCount(uint32 configured)
+{
+    if (configured)
+        return configured;
+
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+void StartupLoader::RunLoader(Loader& loader)
+{
+    uint32 oldMSTime = getMSTime();
+    loader.Function();
+    loader.Duration = GetMSTimeDiffToNow(oldMSTime);
+
+    TC_LOG_DEBUG("server.loading", "%s: %s loaded in %u ms", _name.c_str(), loader.Name.c_str(), loader.Duration);
+}
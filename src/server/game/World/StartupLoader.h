@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef StartupLoader_h__
+#define StartupLoader_h__
+
+#include "Define.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+/// Runs a group of startup loaders on several threads, each one only after the loaders it depends on.
+/// Dependencies have to be added before their dependents, so with a single thread the loaders
+/// run in exactly the order they were added.
+class TC_GAME_API StartupLoader
+{
+public:
+    explicit StartupLoader(std::string const& name) : _name(name) { }
+
+    void Add(std::string const& name, std::function<void()>&& loader, std::vector<std::string> const& dependencies = {});
+
+    /// Returns once all loaders finished, the calling thread is one of threadCount
+    void Run(uint32 threadCount);
+
+    /// Thread count for "Startup.LoaderThreads"
+    static uint32 GetThreadCount(uint32 configured);
+
+private:
+    struct Loader
+    {
+        std::string Name;
+        std::function<void()> Function;
+        std::vector<std::size_t> Dependents;
+        uint32 DependencyCount;
+        uint32 Duration;
+    };
+
+    void RunLoader(Loader& loader);
+
+    std::string _name;
+    std::vector<Loader> _loaders;
+};
+
+#endif // StartupLoader_h__
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WhoListStorage.h"
+#include "Guild.h"
+#include "ObjectAccessor.h"
+#include "Player.h"
+#include "RBAC.h"
+#include "World.h"
+#include "WorldSession.h"
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
+WhoListSnapshot::IndexContainer const* WhoListSnapshot::GetPlayersInZone(uint32 zoneId) const
+{
+    auto itr = _playersByZone.find(zoneId);
+    if (itr == _playersByZone.end())
+        return nullptr;
+
+    return &itr->second;
+}
+
+WhoListStorageMgr::WhoListStorageMgr() : _snapshot(std::make_shared<WhoListSnapshot const>())
+{
+}
+
+WhoListStorageMgr* WhoListStorageMgr::instance()
+{
+    static WhoListStorageMgr instance;
+    return &instance;
+}
+
+void WhoListStorageMgr::Update()
+{
+    std::shared_ptr<WhoListSnapshot> snapshot = std::make_shared<WhoListSnapshot>();
+
+    {
+        boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
+
+        HashMapHolder<Player>::MapType const& m = ObjectAccessor::GetPlayers();
+        snapshot->_players.reserve(m.size());
+        for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+        {
+            Player* player = itr->second;
+            if (!player->IsInWorld())
+                continue;
+
+            WhoListPlayerInfo info;
+            if (!info.PlayerData.Initialize(player->GetGUID(), player))
+                continue;
+
+            info.Name = player->GetName();
+            if (!Utf8toWStr(info.Name, info.LowerName))
+                continue;
+
+            wstrToLower(info.LowerName);
+
+            if (Guild const* guild = player->GetGuild())
+            {
+                info.GuildGuid = guild->GetGUID();
+                info.GuildName = guild->GetName();
+                if (!Utf8toWStr(info.GuildName, info.LowerGuildName))
+                    continue;
+
+                wstrToLower(info.LowerGuildName);
+            }
+
+            info.Guid = player->GetGUID();
+            info.Team = player->GetTeam();
+            info.Security = player->GetSession()->GetSecurity();
+            info.GmListCandidate = player->IsGameMaster() ||
+                (player->GetSession()->HasPermission(rbac::RBAC_PERM_COMMANDS_APPEAR_IN_GM_LIST) &&
+                 info.Security <= AccountTypes(sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_GM_LIST)));
+            info.Level = player->getLevel();
+            info.Class = player->getClass();
+            info.Race = player->getRace();
+            info.ZoneId = player->GetZoneId();
+            snapshot->_players.push_back(std::move(info));
+        }
+    }
+
+    // kept in ObjectAccessor iteration order and not sorted, the who list stops after CONFIG_MAX_WHO players in that order
+    for (uint32 i = 0; i < snapshot->_players.size(); ++i)
+    {
+        WhoListPlayerInfo const& info = snapshot->_players[i];
+        snapshot->_playersByZone[info.ZoneId].push_back(i);
+        snapshot->_playersByLevel[info.Level].push_back(i);
+        if (info.Class < MAX_CLASSES)
+            snapshot->_playersByClass[info.Class].push_back(i);
+    }
+
+    std::atomic_store(&_snapshot, std::shared_ptr<WhoListSnapshot const>(std::move(snapshot)));
+}
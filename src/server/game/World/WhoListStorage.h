@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WhoListStorage_h__
+#define WhoListStorage_h__
+
+#include "Common.h"
+#include "DBCEnums.h"
+#include "ObjectGuid.h"
+#include "QueryPackets.h"
+#include "SharedDefines.h"
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/// Copy of everything the who list filters on from an online player, visibility and GM state are checked on the live player
+struct WhoListPlayerInfo
+{
+    /// Pre-filter of .gm ingame: in GM mode or allowed in the GM list when the snapshot was built
+    bool GmListCandidate = false;
+    WorldPackets::Query::PlayerGuidLookupData PlayerData;
+    ObjectGuid Guid;
+    uint32 Team = 0;
+    AccountTypes Security = SEC_PLAYER;
+    uint8 Level = 0;
+    uint8 Class = 0;
+    uint8 Race = 0;
+    uint32 ZoneId = 0;
+    std::string Name;
+    std::wstring LowerName;
+    ObjectGuid GuildGuid;
+    std::string GuildName;
+    std::wstring LowerGuildName;
+};
+
+/// Immutable list of the players that were in world when it was built, in ObjectAccessor order
+class TC_GAME_API WhoListSnapshot
+{
+public:
+    typedef std::vector<WhoListPlayerInfo> PlayerContainer;
+    typedef std::vector<uint32> IndexContainer;
+
+    PlayerContainer const& GetPlayers() const { return _players; }
+
+    /// Indexes into GetPlayers() of the players in zoneId, ascending
+    IndexContainer const* GetPlayersInZone(uint32 zoneId) const;
+
+    /// Indexes into GetPlayers() of the players of the given level or class, ascending
+    IndexContainer const& GetPlayersOfLevel(uint8 level) const { return _playersByLevel[level]; }
+    IndexContainer const& GetPlayersOfClass(uint8 playerClass) const { return _playersByClass[playerClass]; }
+
+private:
+    friend class WhoListStorageMgr;
+
+    PlayerContainer _players;
+    std::unordered_map<uint32, IndexContainer> _playersByZone;
+    std::array<IndexContainer, STRONG_MAX_LEVEL + 1> _playersByLevel;
+    std::array<IndexContainer, MAX_CLASSES> _playersByClass;
+};
+
+/// Rebuilds the snapshot from ObjectAccessor on the world thread and hands it out without locking,
+/// readers keep using the snapshot they got while the next one replaces it
+class TC_GAME_API WhoListStorageMgr
+{
+private:
+    WhoListStorageMgr();
+    ~WhoListStorageMgr() { }
+
+public:
+    static WhoListStorageMgr* instance();
+
+    void Update();
+
+    std::shared_ptr<WhoListSnapshot const> GetSnapshot() const { return std::atomic_load(&_snapshot); }
+
+private:
+    std::shared_ptr<WhoListSnapshot const> _snapshot;
+};
+
+#define sWhoListStorageMgr WhoListStorageMgr::instance()
+
+#endif // WhoListStorage_h__
@@ -34,6 +34,7 @@
 #include "BattlenetRpcErrorCodes.h"
 #include "BattlePetDataStore.h"
 #include "BlackMarketMgr.h"
+#include "BroadcastPacket.h"
 #include "CalendarMgr.h"
 #include "Channel.h"
 #include "CharacterDatabaseCleaner.h"
@@ -80,6 +81,8 @@
 #include "SkillDiscovery.h"
 #include "SkillExtraItems.h"
 #include "SpellMgr.h"
+#include "StartupLoader.h"
+#include "StartupSnapshot.h"
 #include "SmartScriptMgr.h"
 #include "SupportMgr.h"
 #include "TaxiPathGraph.h"
@@ -91,6 +94,7 @@
 #include "WaypointManager.h"
 #include "WaypointMovementGenerator.h"
 #include "WeatherMgr.h"
+#include "WhoListStorage.h"
 #include "WorldQuestMgr.h"
 #include "WorldSession.h"
 #include "WorldSocket.h"
@@ -1371,6 +1375,17 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = sConfigMgr->GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = sConfigMgr->GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+    m_bool_configs[CONFIG_MAP_PARALLEL_UPDATE] = sConfigMgr->GetBoolDefault("MapUpdate.Parallel.Enabled", false);
+    m_int_configs[CONFIG_MAP_PARALLEL_UPDATE_MIN_GRIDS] = sConfigMgr->GetIntDefault("MapUpdate.Parallel.MinGrids", 4);
+    if (m_int_configs[CONFIG_MAP_PARALLEL_UPDATE_MIN_GRIDS] < 2)
+    {
+        TC_LOG_ERROR("server.loading", "MapUpdate.Parallel.MinGrids (%u) must be >= 2. Using 2 instead.", m_int_configs[CONFIG_MAP_PARALLEL_UPDATE_MIN_GRIDS]);
+        m_int_configs[CONFIG_MAP_PARALLEL_UPDATE_MIN_GRIDS] = 2;
+    }
+    m_int_configs[CONFIG_MAP_EMPTY_INSTANCE_UPDATE_INTERVAL] = sConfigMgr->GetIntDefault("MapUpdate.EmptyInstanceInterval", 0);
+    m_int_configs[CONFIG_GRID_PRELOAD_LOOKAHEAD] = sConfigMgr->GetIntDefault("MapUpdate.GridPreload.LookAhead", 10000);
+    m_bool_configs[CONFIG_MAP_BATCHED_PATHFINDING] = sConfigMgr->GetBoolDefault("MapUpdate.Pathfinding.Batched", true);
+    m_int_configs[CONFIG_STARTUP_LOADER_THREADS] = StartupLoader::GetThreadCount(sConfigMgr->GetIntDefault("Startup.LoaderThreads", 0));
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1568,7 +1583,7 @@ void World::SetInitialWorldSettings()
 
     TC_LOG_INFO("server.loading", "Initialize data stores...");
     ///- Load DB2s
-    sDB2Manager.LoadStores(m_dataPath, m_defaultDbcLocale);
+    sDB2Manager.LoadStores(m_dataPath, m_defaultDbcLocale, getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
     TC_LOG_INFO("misc", "Loading hotfix info...");
     sDB2Manager.LoadHotfixData();
     ///- Close hotfix database - it is only used during DB2 loading
@@ -1636,16 +1651,21 @@ void World::SetInitialWorldSettings()
 
     TC_LOG_INFO("server.loading", "Loading Localization strings...");
     uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadQuestTemplateLocale();
-    sObjectMgr->LoadQuestGreetingLocales();
-    sObjectMgr->LoadQuestOfferRewardLocale();
-    sObjectMgr->LoadQuestRequestItemsLocale();
-    sObjectMgr->LoadQuestObjectivesLocale();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
+    {
+        // each locale table fills its own store
+        StartupLoader localeLoader("Localization strings");
+        localeLoader.Add("creature_template_locale", []() { sObjectMgr->LoadCreatureLocales(); });
+        localeLoader.Add("gameobject_template_locale", []() { sObjectMgr->LoadGameObjectLocales(); });
+        localeLoader.Add("quest_template_locale", []() { sObjectMgr->LoadQuestTemplateLocale(); });
+        localeLoader.Add("quest_greeting_locale", []() { sObjectMgr->LoadQuestGreetingLocales(); });
+        localeLoader.Add("quest_offer_reward_locale", []() { sObjectMgr->LoadQuestOfferRewardLocale(); });
+        localeLoader.Add("quest_request_items_locale", []() { sObjectMgr->LoadQuestRequestItemsLocale(); });
+        localeLoader.Add("quest_objectives_locale", []() { sObjectMgr->LoadQuestObjectivesLocale(); });
+        localeLoader.Add("page_text_locale", []() { sObjectMgr->LoadPageTextLocales(); });
+        localeLoader.Add("gossip_menu_option_locale", []() { sObjectMgr->LoadGossipMenuItemsLocales(); });
+        localeLoader.Add("points_of_interest_locale", []() { sObjectMgr->LoadPointOfInterestLocales(); });
+        localeLoader.Run(getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
+    }
 
     sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
     TC_LOG_INFO("server.loading", ">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
@@ -1755,8 +1775,14 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading Creature Base Stats...");
     sObjectMgr->LoadCreatureClassLevelStats();
 
+    ///- Validated creature and gameobject spawns are reused from the last start while their tables are unchanged
+    StartupSnapshot spawnSnapshot(sConfigMgr->GetStringDefault("Startup.SnapshotFile", ""),
+        { "creature", "game_event_creature", "pool_creature", "creature_template", "creature_equip_template",
+          "gameobject", "game_event_gameobject", "pool_gameobject", "gameobject_template" });
+    spawnSnapshot.Load();
+
     TC_LOG_INFO("server.loading", "Loading Creature Data...");
-    sObjectMgr->LoadCreatures();
+    sObjectMgr->LoadCreatures(spawnSnapshot);
 
     TC_LOG_INFO("server.loading", "Loading Temporary Summon Data...");
     sObjectMgr->LoadTempSummons();                               // must be after LoadCreatureTemplates() and LoadGameObjectTemplates()
@@ -1771,7 +1797,8 @@ void World::SetInitialWorldSettings()
     sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
 
     TC_LOG_INFO("server.loading", "Loading Gameobject Data...");
-    sObjectMgr->LoadGameobjects();
+    sObjectMgr->LoadGameobjects(spawnSnapshot);
+    spawnSnapshot.Save();
 
     TC_LOG_INFO("server.loading", "Loading GameObject Addon Data...");
     sObjectMgr->LoadGameObjectAddons();                          // must be after LoadGameObjectTemplate() and LoadGameobjects()
@@ -2119,6 +2146,7 @@ void World::SetInitialWorldSettings()
     m_timers[WUPDATE_BLACKMARKET].SetInterval(10 * IN_MILLISECONDS);
 
     m_timers[WUPDATE_WORLD_QUEST].SetInterval(1 * MINUTE * IN_MILLISECONDS);
+    m_timers[WUPDATE_WHO_LIST].SetInterval(5 * IN_MILLISECONDS);
 
     blackmarket_timer = 0;
 
@@ -2469,6 +2497,21 @@ void World::Update(uint32 diff)
     sMapMgr->Update(diff);
     RecordTimeDiff("UpdateMapMgr");
 
+    ///- Rebuild the who list while no map is being updated, so the players are in a consistent state
+    if (m_timers[WUPDATE_WHO_LIST].Passed())
+    {
+        m_timers[WUPDATE_WHO_LIST].Reset();
+        sWhoListStorageMgr->Update();
+        RecordTimeDiff("UpdateWhoList");
+    }
+
+    ///- Repack the names of renamed and deleted characters, no map update holds on to a CharacterInfo name here
+    if (_characterInfoStore.CompactNames())
+    {
+        TC_LOG_DEBUG("misc", "Compacted character info names, %u KB in use", uint32(_characterInfoStore.GetMemoryUsage() / 1024));
+        RecordTimeDiff("CompactCharacterInfoNames");
+    }
+
     if (sWorld->getBoolConfig(CONFIG_AUTOBROADCAST))
     {
         if (m_timers[WUPDATE_AUTOBROADCAST].Passed())
@@ -2563,6 +2606,7 @@ void World::ForceGameEventUpdate()
 /// Send a packet to all players (except self if mentioned)
 void World::SendGlobalMessage(WorldPacket const* packet, WorldSession* self, uint32 team)
 {
+    BroadcastPacketPtr broadcast;
     SessionMap::const_iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -2572,7 +2616,10 @@ void World::SendGlobalMessage(WorldPacket const* packet, WorldSession* self, uin
             itr->second != self &&
             (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
         {
-            itr->second->SendPacket(packet);
+            if (!broadcast)
+                broadcast = std::make_shared<BroadcastPacket>(*packet);
+
+            itr->second->SendPacket(broadcast);
         }
     }
 }
@@ -3580,18 +3627,19 @@ void World::ProcessQueryCallbacks()
 
 CharacterInfo const* World::GetCharacterInfo(ObjectGuid const& guid) const
 {
-    CharacterInfoContainer::const_iterator itr = _characterInfoStore.find(guid);
-    if (itr != _characterInfoStore.end())
-        return &itr->second;
+    if (!guid.IsPlayer())
+        return nullptr;
 
-    return nullptr;
+    return _characterInfoStore.Find(guid.GetCounter());
 }
 
 void World::LoadCharacterInfoStore()
 {
     TC_LOG_INFO("server.loading", "Loading character info store");
 
-    _characterInfoStore.clear();
+    uint32 oldMSTime = getMSTime();
+
+    _characterInfoStore.Clear();
 
     QueryResult result = CharacterDatabase.Query("SELECT guid, name, account, race, gender, class, level, deleteDate FROM characters");
     if (!result)
@@ -3600,6 +3648,8 @@ void World::LoadCharacterInfoStore()
         return;
     }
 
+    _characterInfoStore.Reserve(std::size_t(result->GetRowCount()));
+
     do
     {
         Field* fields = result->Fetch();
@@ -3608,13 +3658,14 @@ void World::LoadCharacterInfoStore()
     }
     while (result->NextRow());
 
-    TC_LOG_INFO("server.loading", "Loaded character infos for " SZFMTD " characters", _characterInfoStore.size());
+    TC_LOG_INFO("server.loading", "Loaded character infos for " SZFMTD " characters (" SZFMTD " KB) in %u ms",
+        _characterInfoStore.GetSize(), _characterInfoStore.GetMemoryUsage() / 1024, GetMSTimeDiffToNow(oldMSTime));
 }
 
 void World::AddCharacterInfo(ObjectGuid const& guid, uint32 accountId, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level, bool isDeleted)
 {
-    CharacterInfo& data = _characterInfoStore[guid];
-    data.Name = name;
+    CharacterInfo& data = _characterInfoStore.Insert(guid.GetCounter());
+    _characterInfoStore.SetName(data, name);
     data.AccountId = accountId;
     data.Race = race;
     data.Sex = gender;
@@ -3625,17 +3676,17 @@ void World::AddCharacterInfo(ObjectGuid const& guid, uint32 accountId, std::stri
 
 void World::UpdateCharacterInfo(ObjectGuid const& guid, std::string const& name, uint8 gender /*= GENDER_NONE*/, uint8 race /*= RACE_NONE*/)
 {
-    CharacterInfoContainer::iterator itr = _characterInfoStore.find(guid);
-    if (itr == _characterInfoStore.end())
+    CharacterInfo* characterInfo = _characterInfoStore.Find(guid.GetCounter());
+    if (!characterInfo)
         return;
 
-    itr->second.Name = name;
+    _characterInfoStore.SetName(*characterInfo, name);
 
     if (gender != GENDER_NONE)
-        itr->second.Sex = gender;
+        characterInfo->Sex = gender;
 
     if (race != RACE_NONE)
-        itr->second.Race = race;
+        characterInfo->Race = race;
 
     WorldPackets::Misc::InvalidatePlayer data;
     data.Guid = guid;
@@ -3644,23 +3695,23 @@ void World::UpdateCharacterInfo(ObjectGuid const& guid, std::string const& name,
 
 void World::UpdateCharacterInfoLevel(ObjectGuid const& guid, uint8 level)
 {
-    CharacterInfoContainer::iterator itr = _characterInfoStore.find(guid);
-    if (itr == _characterInfoStore.end())
+    CharacterInfo* characterInfo = _characterInfoStore.Find(guid.GetCounter());
+    if (!characterInfo)
         return;
 
-    itr->second.Level = level;
+    characterInfo->Level = level;
 }
 
 void World::UpdateCharacterInfoDeleted(ObjectGuid const& guid, bool deleted, std::string const* name /*= nullptr*/)
 {
-    CharacterInfoContainer::iterator itr = _characterInfoStore.find(guid);
-    if (itr == _characterInfoStore.end())
+    CharacterInfo* characterInfo = _characterInfoStore.Find(guid.GetCounter());
+    if (!characterInfo)
         return;
 
-    itr->second.IsDeleted = deleted;
+    characterInfo->IsDeleted = deleted;
 
     if (name)
-        itr->second.Name = *name;
+        _characterInfoStore.SetName(*characterInfo, *name);
 }
 
 void World::ReloadRBAC()
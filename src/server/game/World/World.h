@@ -23,6 +23,7 @@
 #ifndef __WORLD_H
 #define __WORLD_H
 
+#include "CharacterInfoStore.h"
 #include "Common.h"
 #include "DatabaseEnvFwd.h"
 #include "LockedQueue.h"
@@ -94,6 +95,7 @@ enum WorldTimers
     WUPDATE_BLACKMARKET,
     WUPDATE_CHECK_FILECHANGES,
     WUPDATE_WORLD_QUEST,
+    WUPDATE_WHO_LIST,
     WUPDATE_COUNT
 };
 
@@ -192,6 +194,8 @@ enum WorldBoolConfigs
     CONFIG_GAME_OBJECT_CHECK_INVALID_POSITION,
     CONFIG_LEGACY_BUFF_ENABLED,
     CONFIG_IGNORE_DUNGEONS_BIND,
+    CONFIG_MAP_PARALLEL_UPDATE,
+    CONFIG_MAP_BATCHED_PATHFINDING,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -404,6 +408,10 @@ enum WorldIntConfigs
     CONFIG_TALENTS_INSPECTING,
     CONFIG_BLACKMARKET_MAXAUCTIONS,
     CONFIG_BLACKMARKET_UPDATE_PERIOD,
+    CONFIG_MAP_PARALLEL_UPDATE_MIN_GRIDS,
+    CONFIG_MAP_EMPTY_INSTANCE_UPDATE_INTERVAL,
+    CONFIG_GRID_PRELOAD_LOOKAHEAD,
+    CONFIG_STARTUP_LOADER_THREADS,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -564,17 +572,6 @@ private:
 
 typedef std::unordered_map<uint32, WorldSession*> SessionMap;
 
-struct CharacterInfo
-{
-    std::string Name;
-    uint32 AccountId;
-    uint8 Class;
-    uint8 Race;
-    uint8 Sex;
-    uint8 Level;
-    bool IsDeleted;
-};
-
 /// The World
 class TC_GAME_API World
 {
@@ -793,11 +790,12 @@ class TC_GAME_API World
 
         CharacterInfo const* GetCharacterInfo(ObjectGuid const& guid) const;
         void AddCharacterInfo(ObjectGuid const& guid, uint32 accountId, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level, bool isDeleted);
-        void DeleteCharacterInfo(ObjectGuid const& guid) { _characterInfoStore.erase(guid); }
-        bool HasCharacterInfo(ObjectGuid const& guid) { return _characterInfoStore.find(guid) != _characterInfoStore.end(); }
+        void DeleteCharacterInfo(ObjectGuid const& guid) { _characterInfoStore.Erase(guid.GetCounter()); }
+        bool HasCharacterInfo(ObjectGuid const& guid) { return GetCharacterInfo(guid) != nullptr; }
         void UpdateCharacterInfo(ObjectGuid const& guid, std::string const& name, uint8 gender = GENDER_NONE, uint8 race = RACE_NONE);
         void UpdateCharacterInfoLevel(ObjectGuid const& guid, uint8 level);
         void UpdateCharacterInfoDeleted(ObjectGuid const& guid, bool deleted, std::string const* name = nullptr);
+        CharacterInfoStore const& GetCharacterInfoStore() const { return _characterInfoStore; }
 
         uint32 GetCleaningFlags() const { return m_CleaningFlags; }
         void   SetCleaningFlags(uint32 flags) { m_CleaningFlags = flags; }
@@ -912,8 +910,7 @@ class TC_GAME_API World
         typedef std::unordered_map<uint8, Autobroadcast> AutobroadcastContainer;
         AutobroadcastContainer m_Autobroadcasts;
 
-        typedef std::map<ObjectGuid, CharacterInfo> CharacterInfoContainer;
-        CharacterInfoContainer _characterInfoStore;
+        CharacterInfoStore _characterInfoStore;
         void LoadCharacterInfoStore();
 
         void ProcessQueryCallbacks();
@@ -31,6 +31,7 @@ EndScriptData */
 #include "Chat.h"
 #include "ChatPackets.h"
 #include "Conversation.h"
+#include "CriteriaHandler.h"
 #include "GossipDef.h"
 #include "GridNotifiersImpl.h"
 #include "Language.h"
@@ -39,14 +40,20 @@ EndScriptData */
 #include "MapManager.h"
 #include "MovementPackets.h"
 #include "MotionMaster.h"
+#include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "PhasingHandler.h"
 #include "RBAC.h"
 #include "SpellPackets.h"
 #include "Transport.h"
 #include "WorldSession.h"
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <algorithm>
 #include <fstream>
+#include <functional>
 #include <limits>
+#include <thread>
 
 class debug_commandscript : public CommandScript
 {
@@ -119,6 +126,9 @@ public:
             { "movementforce", rbac::RBAC_PERM_COMMAND_DEBUG_MOVEMENT_FORCE,false, nullptr,                             "", debugMovementForceCommandTable },
             { "playercondition",rbac::RBAC_PERM_COMMAND_DEBUG,              false, &HandleDebugPlayerConditionCommand,  "" },
             { "maxItemLevel",   rbac::RBAC_PERM_COMMAND_DEBUG,              false, &HandleDebugMaxItemLevelCommand,     "" },
+            { "findplayer",    rbac::RBAC_PERM_COMMAND_DEBUG,               true,  &HandleDebugFindPlayerCommand,       "" },
+            { "auramodifiers", rbac::RBAC_PERM_COMMAND_DEBUG,               false, &HandleDebugAuraModifiersCommand,    "" },
+            { "criteriaindex", rbac::RBAC_PERM_COMMAND_DEBUG,               true,  &HandleDebugCriteriaIndexCommand,    "" },
         };
         static std::vector<ChatCommand> commandTable =
         {
@@ -1691,6 +1701,175 @@ public:
         handler->getSelectedPlayerOrSelf()->SetEffectiveLevelAndMaxItemLevel(effectiveLevel, maxItemLevel);
         return true;
     }
+
+    // USAGE: .debug findplayer [#threads] [#lookups]
+    // Looks up the online players from several threads at once like map threads do, through the guid sharded
+    // ObjectAccessor::FindPlayer and through the global player container lock for comparison
+    static bool HandleDebugFindPlayerCommand(ChatHandler* handler, char const* args)
+    {
+        char* threadsStr = strtok((char*)args, " ");
+        char* lookupsStr = strtok(nullptr, " ");
+
+        uint32 threadCount = threadsStr ? atoul(threadsStr) : 4;
+        uint32 lookups = lookupsStr ? atoul(lookupsStr) : 1000000;
+        if (!threadCount || threadCount > 64 || !lookups)
+            return false;
+
+        GuidVector guids;
+        {
+            boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
+            for (std::pair<ObjectGuid const, Player*> const& player : ObjectAccessor::GetPlayers())
+                guids.push_back(player.first);
+        }
+
+        if (guids.empty())
+        {
+            handler->SendSysMessage("No players online.");
+            return true;
+        }
+
+        // the world thread waits here, so map threads are idle and the players cannot change
+        auto measure = [&](std::function<bool(ObjectGuid const&)> const& find) -> uint32
+        {
+            std::vector<std::thread> threads;
+            uint32 startTime = getMSTime();
+            for (uint32 t = 0; t < threadCount; ++t)
+            {
+                threads.emplace_back([&, t]()
+                {
+                    for (uint32 i = 0; i < lookups; ++i)
+                        find(guids[(i + t) % guids.size()]);
+                });
+            }
+
+            for (std::thread& thread : threads)
+                thread.join();
+
+            return getMSTimeDiff(startTime, getMSTime());
+        };
+
+        uint32 shardedTime = measure([](ObjectGuid const& guid)
+        {
+            return ObjectAccessor::FindPlayer(guid) != nullptr;
+        });
+
+        uint32 globalLockTime = measure([](ObjectGuid const& guid)
+        {
+            boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
+            return ObjectAccessor::GetPlayers().count(guid) != 0;
+        });
+
+        handler->PSendSysMessage("%u threads, %u lookups each over " SZFMTD " online players:", threadCount, lookups, guids.size());
+        handler->PSendSysMessage("FindPlayer (guid shards): %u ms", shardedTime);
+        handler->PSendSysMessage("Global player lock: %u ms", globalLockTime);
+        return true;
+    }
+
+    // USAGE: .debug auramodifiers [#iterations]
+    // Queries the total modifier and multiplier of every aura type present on the selected unit, as the damage and
+    // healing bonus code does on each hit, through the cached totals and by walking the aura effect lists
+    static bool HandleDebugAuraModifiersCommand(ChatHandler* handler, char const* args)
+    {
+        Unit* unit = handler->getSelectedUnit();
+        if (!unit)
+        {
+            handler->SendSysMessage(LANG_SELECT_CHAR_OR_CREATURE);
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        uint32 iterations = *args ? atoul(args) : 100000;
+        if (!iterations)
+            return false;
+
+        std::vector<AuraType> auraTypes;
+        for (uint32 auraType = 0; auraType < TOTAL_AURAS; ++auraType)
+            if (!unit->GetAuraEffectsByType(AuraType(auraType)).empty())
+                auraTypes.push_back(AuraType(auraType));
+
+        if (auraTypes.empty())
+        {
+            handler->PSendSysMessage("%s has no aura effects.", unit->GetName().c_str());
+            return true;
+        }
+
+        auto measure = [&](std::function<void(AuraType)> const& query) -> uint32
+        {
+            uint32 startTime = getMSTime();
+            for (uint32 i = 0; i < iterations; ++i)
+                for (AuraType auraType : auraTypes)
+                    query(auraType);
+
+            return getMSTimeDiff(startTime, getMSTime());
+        };
+
+        uint32 cachedTime = measure([unit](AuraType auraType)
+        {
+            unit->GetTotalAuraModifier(auraType);
+            unit->GetTotalAuraMultiplier(auraType);
+        });
+
+        uint32 walkedTime = measure([unit](AuraType auraType)
+        {
+            unit->GetTotalAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+            unit->GetTotalAuraMultiplier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+        });
+
+        handler->PSendSysMessage("%s: %u iterations over " SZFMTD " aura types with effects:", unit->GetName().c_str(), iterations, auraTypes.size());
+        handler->PSendSysMessage("Cached totals: %u ms", cachedTime);
+        handler->PSendSysMessage("Effect list walk: %u ms", walkedTime);
+        return true;
+    }
+
+    // USAGE: .debug criteriaindex [#iterations]
+    // Replays a kill, loot and quest completion event for every asset used by player criteria of these types and
+    // compares the candidates found by scanning all criteria of the type with the (type, asset) index.
+    // Only the candidate selection of CriteriaHandler::UpdateCriteria is measured, no criteria progress is changed.
+    static bool HandleDebugCriteriaIndexCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 iterations = *args ? atoul(args) : 100;
+        if (!iterations)
+            return false;
+
+        for (CriteriaTypes type : { CRITERIA_TYPE_KILL_CREATURE, CRITERIA_TYPE_LOOT_ITEM, CRITERIA_TYPE_COMPLETE_QUEST })
+        {
+            CriteriaList const& criteriaOfType = sCriteriaMgr->GetPlayerCriteriaByType(type);
+
+            std::vector<uint32> assets;
+            for (Criteria const* criteria : criteriaOfType)
+                if (criteria->Entry->Asset.ID)
+                    assets.push_back(criteria->Entry->Asset.ID);
+
+            std::sort(assets.begin(), assets.end());
+            assets.erase(std::unique(assets.begin(), assets.end()), assets.end());
+            if (assets.empty())
+                continue;
+
+            uint64 scannedCandidates = 0;
+            uint32 startTime = getMSTime();
+            for (uint32 i = 0; i < iterations; ++i)
+                for (uint32 asset : assets)
+                    for (Criteria const* criteria : criteriaOfType)
+                        if (criteria->Entry->Asset.ID == asset)
+                            ++scannedCandidates;
+
+            uint32 scanTime = getMSTimeDiff(startTime, getMSTime());
+
+            uint64 indexedCandidates = 0;
+            startTime = getMSTime();
+            for (uint32 i = 0; i < iterations; ++i)
+                for (uint32 asset : assets)
+                    indexedCandidates += sCriteriaMgr->GetPlayerCriteriaByAsset(type, asset).size();
+
+            uint32 indexTime = getMSTimeDiff(startTime, getMSTime());
+
+            handler->PSendSysMessage("%s: " SZFMTD " criteria, " SZFMTD " assets, %u events each", CriteriaMgr::GetCriteriaTypeString(type), criteriaOfType.size(), assets.size(), iterations);
+            handler->PSendSysMessage("  type scan: " SZFMTD " criteria tested per event, " UI64FMTD " matches, %u ms", criteriaOfType.size(), scannedCandidates, scanTime);
+            handler->PSendSysMessage("  asset index: " UI64FMTD " matches, %u ms", indexedCandidates, indexTime);
+        }
+
+        return true;
+    }
 };
 
 void AddSC_debug_commandscript()
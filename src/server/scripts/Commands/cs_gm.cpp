@@ -32,9 +32,8 @@ EndScriptData */
 #include "Realm.h"
 #include "ScriptMgr.h"
 #include "World.h"
+#include "WhoListStorage.h"
 #include "WorldSession.h"
-#include <boost/thread/shared_mutex.hpp>
-#include <boost/thread/locks.hpp>
 
 class gm_commandscript : public CommandScript
 {
@@ -129,15 +128,23 @@ public:
         bool first = true;
         bool footer = false;
 
-        boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
-        HashMapHolder<Player>::MapType const& m = ObjectAccessor::GetPlayers();
-        for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+        // taken from the who list snapshot, so GMs that just logged in or turned GM mode on may be missing for a few seconds
+        std::shared_ptr<WhoListSnapshot const> snapshot = sWhoListStorageMgr->GetSnapshot();
+        for (WhoListPlayerInfo const& target : snapshot->GetPlayers())
         {
-            AccountTypes itrSec = itr->second->GetSession()->GetSecurity();
-            if ((itr->second->IsGameMaster() ||
-                (itr->second->GetSession()->HasPermission(rbac::RBAC_PERM_COMMANDS_APPEAR_IN_GM_LIST) &&
+            if (!target.GmListCandidate)
+                continue;
+
+            // gm mode and visibility change at any time, check them on the live player
+            Player* player = ObjectAccessor::FindConnectedPlayer(target.Guid);
+            if (!player || !player->IsInWorld())
+                continue;
+
+            AccountTypes itrSec = player->GetSession()->GetSecurity();
+            if ((player->IsGameMaster() ||
+                (player->GetSession()->HasPermission(rbac::RBAC_PERM_COMMANDS_APPEAR_IN_GM_LIST) &&
                  itrSec <= AccountTypes(sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_GM_LIST)))) &&
-                (!handler->GetSession() || itr->second->IsVisibleGloballyFor(handler->GetSession()->GetPlayer())))
+                (!handler->GetSession() || player->IsVisibleGloballyFor(handler->GetSession()->GetPlayer())))
             {
                 if (first)
                 {
@@ -146,7 +153,7 @@ public:
                     handler->SendSysMessage(LANG_GMS_ON_SRV);
                     handler->SendSysMessage("========================");
                 }
-                std::string const& name = itr->second->GetName();
+                std::string const& name = player->GetName();
                 uint8 size = name.size();
                 uint8 security = itrSec;
                 uint8 max = ((16 - size) / 2);
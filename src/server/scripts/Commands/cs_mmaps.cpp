@@ -37,6 +37,7 @@
 #include "RBAC.h"
 #include "TargetedMovementGenerator.h"
 #include "WorldSession.h"
+#include <thread>
 
 class mmaps_commandscript : public CommandScript
 {
@@ -261,8 +262,14 @@ public:
         return true;
     }
 
-    static bool HandleMmapTestArea(ChatHandler* handler, char const* /*args*/)
+    // USAGE: .mmap testarea [#threads]
+    // paths of the creatures around are split between the threads, navmesh queries are pooled so they run concurrently
+    static bool HandleMmapTestArea(ChatHandler* handler, char const* args)
     {
+        uint32 threadCount = *args ? atoul(args) : 1;
+        if (!threadCount || threadCount > 64)
+            return false;
+
         float radius = 40.0f;
         WorldObject* object = handler->GetSession()->GetPlayer();
 
@@ -276,20 +283,34 @@ public:
         {
             handler->PSendSysMessage("Found %zu Creatures.", creatureList.size());
 
-            uint32 paths = 0;
+            uint32 paths = uint32(creatureList.size());
             uint32 uStartTime = getMSTime();
 
             float gx, gy, gz;
             object->GetPosition(gx, gy, gz);
-            for (std::list<Creature*>::iterator itr = creatureList.begin(); itr != creatureList.end(); ++itr)
+
+            // generators are set up here and only calculated by the workers, like batched map path requests;
+            // the world thread waits for the workers, so the creatures do not move meanwhile
+            std::vector<std::unique_ptr<PathGenerator>> pathGenerators;
+            pathGenerators.reserve(creatureList.size());
+            for (Creature* creature : creatureList)
+                pathGenerators.push_back(Trinity::make_unique<PathGenerator>(creature));
+
+            std::vector<std::thread> threads;
+            for (uint32 t = 0; t < threadCount; ++t)
             {
-                PathGenerator path(*itr);
-                path.CalculatePath(gx, gy, gz);
-                ++paths;
+                threads.emplace_back([&pathGenerators, t, threadCount, gx, gy, gz]()
+                {
+                    for (size_t i = t; i < pathGenerators.size(); i += threadCount)
+                        pathGenerators[i]->CalculatePath(gx, gy, gz);
+                });
             }
 
+            for (std::thread& thread : threads)
+                thread.join();
+
             uint32 uPathLoadTime = getMSTimeDiff(uStartTime, getMSTime());
-            handler->PSendSysMessage("Generated %i paths in %i ms", paths, uPathLoadTime);
+            handler->PSendSysMessage("Generated %i paths in %i ms using %u threads", paths, uPathLoadTime, threadCount);
         }
         else
             handler->PSendSysMessage("No creatures in %f yard range.", radius);
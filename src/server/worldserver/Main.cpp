@@ -177,8 +177,7 @@ extern int main(int argc, char** argv)
     std::shared_ptr<Trinity::Asio::IoContext> ioContext = std::make_shared<Trinity::Asio::IoContext>();
 
     sLog->RegisterAppender<AppenderDB>();
-    // If logs are supposed to be handled async then we need to pass the IoContext into the Log singleton
-    sLog->Initialize(sConfigMgr->GetBoolDefault("Log.Async.Enable", false) ? ioContext.get() : nullptr);
+    sLog->Initialize(sConfigMgr->GetBoolDefault("Log.Async.Enable", false));
 
     Trinity::Banner::Show("worldserver-daemon",
         [](char const* text)
@@ -260,6 +259,15 @@ extern int main(int argc, char** argv)
     sMetric->Initialize(realm.Name, *ioContext, []()
     {
         TC_METRIC_VALUE("online_players", sWorld->GetPlayerCount());
+
+        uint64 bytesCompressed, bytesSent;
+        WorldSocket::ConsumeCompressionStatistics(bytesCompressed, bytesSent);
+        TC_METRIC_VALUE("packet_bytes_compressed", bytesCompressed);
+        TC_METRIC_VALUE("compressed_packet_bytes_sent", bytesSent);
+
+        CharacterInfoStore const& characterInfoStore = sWorld->GetCharacterInfoStore();
+        TC_METRIC_VALUE("character_info_entries", uint64(characterInfoStore.GetSize()));
+        TC_METRIC_VALUE("character_info_memory", uint64(characterInfoStore.GetMemoryUsage()));
     });
 
     TC_METRIC_EVENT("events", "Worldserver started", "");
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// Measures the cost of log statements that are filtered out, with and without the per call site logger cache
+
+#include "Config.h"
+#include "Log.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+namespace
+{
+    char const* const ConfigFile = "log_benchmark.conf";
+
+    template<typename Statement>
+    double MeasureNanosecondsPerCall(uint32 iterations, Statement&& statement)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < iterations; ++i)
+            statement(i);
+
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32 iterations = argc > 1 ? uint32(strtoul(argv[1], nullptr, 10)) : 10000000;
+    if (!iterations)
+    {
+        printf("Usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    {
+        // errors only, except one debug logger that keeps the lowest log level at debug
+        // so filtered out debug statements of other loggers reach the logger lookup like on a live server
+        std::ofstream config(ConfigFile);
+        config << "[log_benchmark]\n"
+            "Appender.Console=1,2,0\n"
+            "Logger.root=5,Console\n"
+            "Logger.maps=2,Console\n";
+    }
+
+    std::string configError;
+    bool configLoaded = sConfigMgr->LoadInitial(ConfigFile, std::vector<std::string>(), configError);
+    std::remove(ConfigFile);
+    if (!configLoaded)
+    {
+        printf("Error in config file: %s\n", configError.c_str());
+        return 1;
+    }
+
+    sLog->Initialize(false);
+
+    double cached = MeasureNanosecondsPerCall(iterations, [](uint32 i)
+    {
+        TC_LOG_DEBUG("entities.unit.auras", "Aura effect %u", i);
+    });
+
+    double lookedUp = MeasureNanosecondsPerCall(iterations, [](uint32 i)
+    {
+        if (sLog->ShouldLog("entities.unit.auras", LOG_LEVEL_DEBUG))
+            sLog->outMessage("entities.unit.auras", LOG_LEVEL_DEBUG, "Aura effect %u", i);
+    });
+
+    printf("Filtered out statement, %u calls each:\n", iterations);
+    printf("  TC_LOG_DEBUG (call site cache):   %8.2f ns/call\n", cached);
+    printf("  ShouldLog(std::string) lookup:    %8.2f ns/call\n", lookedUp);
+
+    sLog->Close();
+    return 0;
+}
@@ -366,7 +366,7 @@ bool ReadCinematicCameraDBC()
 
 // Map file format data
 static char const* MAP_MAGIC         = "MAPS";
-static char const* MAP_VERSION_MAGIC = "v1.9";
+static char const* MAP_VERSION_MAGIC = "v2.0";
 static char const* MAP_AREA_MAGIC    = "AREA";
 static char const* MAP_HEIGHT_MAGIC  = "MHGT";
 static char const* MAP_LIQUID_MAGIC  = "MLIQ";
@@ -494,6 +494,22 @@ bool TransformToHighRes(uint16 lowResHoles, uint8 hiResHoles[8])
     return *((uint64*)hiResHoles) != 0;
 }
 
+// every section starts at a 16 byte boundary so the server can use the arrays straight from a memory mapped file
+static uint32 const MAP_SECTION_ALIGNMENT = 16;
+
+uint32 AlignMapSection(uint32 offset)
+{
+    return (offset + MAP_SECTION_ALIGNMENT - 1) & ~(MAP_SECTION_ALIGNMENT - 1);
+}
+
+void WriteMapSectionPadding(std::ofstream& outFile, uint32 sectionOffset)
+{
+    static char const padding[MAP_SECTION_ALIGNMENT] = { };
+    std::streamoff position = outFile.tellp();
+    if (position < sectionOffset)
+        outFile.write(padding, sectionOffset - position);
+}
+
 bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int /*cell_y*/, int /*cell_x*/, uint32 build, bool ignoreDeepWater)
 {
     ChunkedFile adt;
@@ -748,7 +764,7 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
         }
     }
 
-    map.areaMapOffset = sizeof(map);
+    map.areaMapOffset = AlignMapSection(sizeof(map));
     map.areaMapSize   = sizeof(map_areaHeader);
 
     map_areaHeader areaHeader;
@@ -806,7 +822,7 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
             maxHeight = CONF_use_minHeight;
     }
 
-    map.heightMapOffset = map.areaMapOffset + map.areaMapSize;
+    map.heightMapOffset = AlignMapSection(map.areaMapOffset + map.areaMapSize);
     map.heightMapSize = sizeof(map_heightHeader);
 
     map_heightHeader heightHeader;
@@ -925,7 +941,7 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
                     liquid_height[y][x] = CONF_use_minHeight;
             }
         }
-        map.liquidMapOffset = map.heightMapOffset + map.heightMapSize;
+        map.liquidMapOffset = AlignMapSection(map.heightMapOffset + map.heightMapSize);
         map.liquidMapSize = sizeof(map_liquidHeader);
         liquidHeader.fourcc = *reinterpret_cast<uint32 const*>(MAP_LIQUID_MAGIC);
         liquidHeader.flags = 0;
@@ -961,9 +977,9 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
     if (hasHoles)
     {
         if (map.liquidMapOffset)
-            map.holesOffset = map.liquidMapOffset + map.liquidMapSize;
+            map.holesOffset = AlignMapSection(map.liquidMapOffset + map.liquidMapSize);
         else
-            map.holesOffset = map.heightMapOffset + map.heightMapSize;
+            map.holesOffset = AlignMapSection(map.heightMapOffset + map.heightMapSize);
 
         map.holesSize = sizeof(holes);
     }
@@ -983,11 +999,13 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
 
     outFile.write(reinterpret_cast<const char*>(&map), sizeof(map));
     // Store area data
+    WriteMapSectionPadding(outFile, map.areaMapOffset);
     outFile.write(reinterpret_cast<const char*>(&areaHeader), sizeof(areaHeader));
     if (!(areaHeader.flags & MAP_AREA_NO_AREA))
         outFile.write(reinterpret_cast<const char*>(area_ids), sizeof(area_ids));
 
     // Store height data
+    WriteMapSectionPadding(outFile, map.heightMapOffset);
     outFile.write(reinterpret_cast<const char*>(&heightHeader), sizeof(heightHeader));
     if (!(heightHeader.flags & MAP_HEIGHT_NO_HEIGHT))
     {
@@ -1017,6 +1035,7 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
     // Store liquid data if need
     if (map.liquidMapOffset)
     {
+        WriteMapSectionPadding(outFile, map.liquidMapOffset);
         outFile.write(reinterpret_cast<const char*>(&liquidHeader), sizeof(liquidHeader));
         if (!(liquidHeader.flags & MAP_LIQUID_NO_TYPE))
         {
@@ -1033,7 +1052,10 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
 
     // store hole data
     if (hasHoles)
+    {
+        WriteMapSectionPadding(outFile, map.holesOffset);
         outFile.write(reinterpret_cast<const char*>(holes), map.holesSize);
+    }
 
     outFile.close();
 
@@ -79,7 +79,8 @@ struct map_liquidHeader
 
 namespace MMAP
 {
-    char const* MAP_VERSION_MAGIC = "v1.9";
+    char const* MAP_VERSION_MAGIC = "v2.0";
+    char const* MAP_LEGACY_VERSION_MAGIC = "v1.9";   // same layout without section alignment
 
     TerrainBuilder::TerrainBuilder(bool skipLiquid) : m_skipLiquid (skipLiquid){ }
     TerrainBuilder::~TerrainBuilder() { }
@@ -151,7 +152,7 @@ namespace MMAP
 
         map_fileheader fheader;
         if (fread(&fheader, sizeof(map_fileheader), 1, mapFile) != 1 ||
-            fheader.versionMagic != *((uint32 const*)(MAP_VERSION_MAGIC)))
+            (fheader.versionMagic != *((uint32 const*)(MAP_VERSION_MAGIC)) && fheader.versionMagic != *((uint32 const*)(MAP_LEGACY_VERSION_MAGIC))))
         {
             fclose(mapFile);
             printf("%s is the wrong version, please extract new .map files\n", mapFileName);